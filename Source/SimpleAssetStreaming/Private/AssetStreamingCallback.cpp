@@ -28,4 +28,8 @@ SOFTWARE.
 
 void IAssetStreamingCallback::OnAssetLoaded_Implementation(const TSoftObjectPtr<UObject>& LoadedAsset, const bool bWasAlreadyLoaded)
 {
+}
+
+void IAssetStreamingCallback::OnAssetBatchLoaded_Implementation(const TArray<TSoftObjectPtr<UObject>>& LoadedAssets)
+{
 }
\ No newline at end of file
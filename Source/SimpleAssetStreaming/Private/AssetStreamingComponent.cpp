@@ -0,0 +1,74 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingComponent.h"
+#include "AssetStreamingSubsystem.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UAssetStreamingComponent::UAssetStreamingComponent()
+	: Assets()
+	, EnterRadius(5000.0f)
+	, ExitRadius(6000.0f)
+	, Priority(EAssetStreamingPriority::Normal)
+	, bStreamAsBatch(false)
+	, StreamingOffset(FVector::ZeroVector)
+	, bIsMovable(false)
+	, StreamingSubsystem()
+	, ProximityIndex(INDEX_NONE)
+	, bIsStreamingAssets(false)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UAssetStreamingComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+	UAssetStreamingSubsystem* Subsystem = GameInstance ? GameInstance->GetSubsystem<UAssetStreamingSubsystem>() : nullptr;
+	if (Subsystem)
+	{
+		Subsystem->RegisterStreamingComponent(this);
+	}
+}
+
+void UAssetStreamingComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAssetStreamingSubsystem* Subsystem = StreamingSubsystem.Get())
+	{
+		Subsystem->UnregisterStreamingComponent(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FVector UAssetStreamingComponent::GetStreamingLocation() const
+{
+	const AActor* Owner = GetOwner();
+	return Owner ? Owner->GetActorLocation() + StreamingOffset : StreamingOffset;
+}
@@ -0,0 +1,96 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingDependencies.h"
+#include "AssetRegistryModule.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+
+const TArray<FSoftObjectPath>& FAssetStreamingDependencies::Expand(const FSoftObjectPath& AssetPath, const int32 MaxDependencies)
+{
+	const FName RootPackageName(*AssetPath.GetLongPackageName());
+	const TPair<FName, int32> ExpansionKey(RootPackageName, MaxDependencies);
+	if (const TArray<FSoftObjectPath>* FoundDependencies = Expansions.Find(ExpansionKey))
+	{
+		return *FoundDependencies;
+	}
+
+	if (Expansions.Num() >= MaxCachedExpansions)
+	{
+		Expansions.Reset();
+	}
+
+	TArray<FSoftObjectPath>& Dependencies = Expansions.Add(ExpansionKey);
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	// Walk breadth first, so that the closest dependencies are kept when there are too many.
+	TArray<FName> PackagesToVisit;
+	TSet<FName> VisitedPackages;
+	PackagesToVisit.Add(RootPackageName);
+	VisitedPackages.Add(RootPackageName);
+
+	TArray<FName> PackageDependencies;
+	TArray<FAssetData> PackageAssets;
+
+	for (int32 VisitIndex = 0; VisitIndex < PackagesToVisit.Num() && Dependencies.Num() < MaxDependencies; VisitIndex++)
+	{
+		PackageDependencies.Reset();
+		AssetRegistry.GetDependencies(PackagesToVisit[VisitIndex], PackageDependencies, EAssetRegistryDependencyType::Hard);
+
+		for (const FName DependencyName : PackageDependencies)
+		{
+			bool bIsAlreadyVisited;
+			VisitedPackages.Add(DependencyName, &bIsAlreadyVisited);
+			if (bIsAlreadyVisited || FPackageName::IsScriptPackage(DependencyName.ToString())) continue;
+
+			PackageAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(DependencyName, PackageAssets);
+			if (PackageAssets.Num() == 0) continue;
+
+			for (const FAssetData& AssetData : PackageAssets)
+			{
+				if (Dependencies.Num() >= MaxDependencies) break;
+				Dependencies.Add(FSoftObjectPath(AssetData.ObjectPath));
+			}
+
+			PackagesToVisit.Add(DependencyName);
+		}
+	}
+
+	Dependencies.Shrink();
+	return Dependencies;
+}
+
+SIZE_T FAssetStreamingDependencies::GetAllocatedSize() const
+{
+	SIZE_T Size = Expansions.GetAllocatedSize();
+	for (const TPair<TPair<FName, int32>, TArray<FSoftObjectPath>>& Expansion : Expansions)
+	{
+		Size += Expansion.Value.GetAllocatedSize();
+	}
+
+	return Size;
+}
@@ -0,0 +1,87 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingFileFormat.h"
+
+void FAssetStreamingFileFormat::SaveHeader(FArchive& Writer, const uint32 Magic, const uint32 Version)
+{
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	Writer << FileMagic << FileVersion;
+}
+
+bool FAssetStreamingFileFormat::LoadHeader(FArchive& Reader, const uint32 Magic, const uint32 Version)
+{
+	uint32 FileMagic = 0;
+	uint32 FileVersion = 0;
+	Reader << FileMagic << FileVersion;
+
+	return !Reader.IsError() && FileMagic == Magic && FileVersion == Version;
+}
+
+void FAssetStreamingFileFormat::SaveCount(FArchive& Writer, const int32 Count)
+{
+	int32 FileCount = Count;
+	Writer << FileCount;
+}
+
+bool FAssetStreamingFileFormat::LoadCount(FArchive& Reader, const int32 MaxCount, int32& OutCount)
+{
+	OutCount = 0;
+	Reader << OutCount;
+
+	return !Reader.IsError() && OutCount >= 0 && OutCount <= MaxCount;
+}
+
+void FAssetStreamingFileFormat::SaveAssetPaths(FArchive& Writer, const TArray<FSoftObjectPath>& AssetPaths)
+{
+	// Paths are written as strings rather than soft object paths, so that saving them doesn't go through redirectors or the soft reference tracking.
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		FString PathString = AssetPath.ToString();
+		Writer << PathString;
+	}
+}
+
+bool FAssetStreamingFileFormat::LoadAssetPaths(FArchive& Reader, const int32 NumAssetPaths, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	OutAssetPaths.Reset(NumAssetPaths);
+
+	FString PathString;
+	for (int32 Index = 0; Index < NumAssetPaths && !Reader.IsError(); Index++)
+	{
+		Reader << PathString;
+		OutAssetPaths.Add(FSoftObjectPath(PathString));
+	}
+
+	if (Reader.IsError())
+	{
+		OutAssetPaths.Reset();
+		return false;
+	}
+
+	return true;
+}
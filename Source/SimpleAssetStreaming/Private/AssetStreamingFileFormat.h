@@ -0,0 +1,60 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Serialization shared by the binary files of the subsystem, startup manifests and traces.
+ * Files start with a magic number and a version, followed by counts bounded to reject corrupted files before allocating.
+ */
+struct FAssetStreamingFileFormat
+{
+	// Upper bound on the number of asset paths of a file.
+	static constexpr int32 MaxAssetPaths = 1 << 20;
+
+	static void SaveHeader(FArchive& Writer, const uint32 Magic, const uint32 Version);
+
+	// Returns false if the file doesn't start with the expected magic number and version.
+	static bool LoadHeader(FArchive& Reader, const uint32 Magic, const uint32 Version);
+
+	static void SaveCount(FArchive& Writer, const int32 Count);
+
+	// Returns false if the count can't be read or is out of bounds.
+	static bool LoadCount(FArchive& Reader, const int32 MaxCount, int32& OutCount);
+
+	static void SaveAssetPaths(FArchive& Writer, const TArray<FSoftObjectPath>& AssetPaths);
+
+	/**
+	 * Read asset paths written by SaveAssetPaths().
+	 * @param Reader The archive to read.
+	 * @param NumAssetPaths The number of paths to read, read with LoadCount() beforehand.
+	 * @param OutAssetPaths The paths that were read. Empty if the file is truncated.
+	 * @returns False if the file is truncated.
+	 */
+	static bool LoadAssetPaths(FArchive& Reader, const int32 NumAssetPaths, TArray<FSoftObjectPath>& OutAssetPaths);
+};
@@ -0,0 +1,82 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingLatencyHistogram.h"
+
+void FAssetStreamingLatencyHistogram::Add(const double LatencySeconds)
+{
+	const double LatencyMs = FMath::Max(LatencySeconds * 1000.0, 0.0);
+
+	// Find the first bucket whose upper bound is above the sample, the last bucket takes the rest.
+	int32 Bucket = 0;
+	while (Bucket < NumBuckets - 1 && LatencyMs >= GetBucketUpperBoundMs(Bucket))
+	{
+		Bucket++;
+	}
+
+	Buckets[Bucket]++;
+	NumSamples++;
+	TotalMs += LatencyMs;
+	MaxMs = FMath::Max(MaxMs, LatencyMs);
+}
+
+void FAssetStreamingLatencyHistogram::Reset()
+{
+	FMemory::Memzero(Buckets);
+	NumSamples = 0;
+	TotalMs = 0.0;
+	MaxMs = 0.0;
+}
+
+double FAssetStreamingLatencyHistogram::GetPercentileMs(const double Percentile) const
+{
+	if (NumSamples == 0) return 0.0;
+
+	const uint32 Target = FMath::Max(1u, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * NumSamples)));
+	uint32 Count = 0;
+
+	for (int32 Bucket = 0; Bucket < NumBuckets - 1; Bucket++)
+	{
+		Count += Buckets[Bucket];
+		if (Count >= Target) return FMath::Min(GetBucketUpperBoundMs(Bucket), MaxMs);
+	}
+
+	return MaxMs;
+}
+
+FString FAssetStreamingLatencyHistogram::ToString() const
+{
+	FString Result = FString::Printf(TEXT("%u samples, avg %.2fms, p50 %.0fms, p95 %.0fms, p99 %.0fms, max %.2fms |"),
+		NumSamples, GetAverageMs(), GetPercentileMs(0.5), GetPercentileMs(0.95), GetPercentileMs(0.99), MaxMs);
+
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		if (Bucket < NumBuckets - 1) Result += FString::Printf(TEXT(" <%.0fms: %u"), GetBucketUpperBoundMs(Bucket), Buckets[Bucket]);
+		else Result += FString::Printf(TEXT(" >=%.0fms: %u"), GetBucketUpperBoundMs(Bucket - 1), Buckets[Bucket]);
+	}
+
+	return Result;
+}
@@ -0,0 +1,98 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingLoadOrder.h"
+#include "AssetRegistryModule.h"
+#include "HAL/PlatformFilemanager.h"
+#include "IPlatformFilePak.h"
+#include "Misc/PackageName.h"
+#include "Modules/ModuleManager.h"
+
+FAssetStreamingLoadOrderKey FAssetStreamingLoadOrder::GetKey(const FSoftObjectPath& AssetPath)
+{
+	const FName PackageName(*AssetPath.GetLongPackageName());
+	if (const FAssetStreamingLoadOrderKey* FoundKey = Keys.Find(PackageName))
+	{
+		return *FoundKey;
+	}
+
+	if (Keys.Num() >= MaxCachedKeys)
+	{
+		Keys.Reset();
+	}
+
+	FAssetStreamingLoadOrderKey Key;
+	Key.PackageName = PackageName;
+
+	// The asset registry knows which chunk the package was cooked to, without loading it.
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const FAssetData AssetData = AssetRegistry.GetAssetByObjectPath(AssetPath.GetAssetPathName());
+	if (AssetData.IsValid() && AssetData.ChunkIDs.Num() > 0)
+	{
+		Key.ChunkId = AssetData.ChunkIDs[0];
+	}
+
+	// The pak file knows where the package is in the file. The platform file is only looked up once, it doesn't change once mounted.
+	if (!bHasFoundPakPlatformFile)
+	{
+		bHasFoundPakPlatformFile = true;
+		PakPlatformFile = static_cast<FPakPlatformFile*>(FPlatformFileManager::Get().FindPlatformFile(FPakPlatformFile::GetTypeName()));
+	}
+
+	FString PackageFilename;
+	if (PakPlatformFile && FPackageName::TryConvertLongPackageNameToFilename(PackageName.ToString(), PackageFilename, FPackageName::GetAssetPackageExtension()))
+	{
+		FPakEntry Entry;
+		if (PakPlatformFile->FindFileInPakFiles(*PackageFilename, nullptr, &Entry))
+		{
+			Key.Offset = Entry.Offset;
+		}
+	}
+
+	Keys.Add(PackageName, Key);
+	return Key;
+}
+
+void FAssetStreamingLoadOrder::Sort(TArray<FSoftObjectPath>& AssetPaths)
+{
+	if (AssetPaths.Num() < 2) return;
+
+	// Resolve every key once rather than on every comparison.
+	TArray<TPair<FAssetStreamingLoadOrderKey, FSoftObjectPath>> SortedPaths;
+	SortedPaths.Reserve(AssetPaths.Num());
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		SortedPaths.Emplace(GetKey(AssetPath), AssetPath);
+	}
+
+	// Assets of the same package keep their order.
+	SortedPaths.StableSort([](const TPair<FAssetStreamingLoadOrderKey, FSoftObjectPath>& A, const TPair<FAssetStreamingLoadOrderKey, FSoftObjectPath>& B) { return A.Key < B.Key; });
+
+	for (int32 Index = 0; Index < SortedPaths.Num(); Index++)
+	{
+		AssetPaths[Index] = SortedPaths[Index].Value;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingPredictor.h"
+
+void FAssetStreamingPredictor::Initialize(const int32 NumEntries, const float InWindowSeconds)
+{
+	const uint32 TableSize = FMath::RoundUpToPowerOfTwo(FMath::Max(NumEntries, 1));
+	Table.SetNumZeroed(TableSize);
+	TableMask = TableSize - 1;
+	WindowSeconds = InWindowSeconds;
+}
+
+void FAssetStreamingPredictor::Observe(const FSoftObjectPath& AssetPath, const double Now, const float MinConfidence, TArray<FSoftObjectPath>& OutPredictions)
+{
+	// Zero marks empty entries.
+	const uint32 PathHash = FMath::Max(GetTypeHash(AssetPath), 1u);
+
+	// The request follows every recent request of the window.
+	for (const FWindowEntry& Previous : Window)
+	{
+		if (Previous.PathHash == 0 || Previous.PathHash == PathHash || Now - Previous.Time > WindowSeconds) continue;
+
+		FEntry& Source = Table[Previous.PathHash & TableMask];
+		if (Source.PathHash == Previous.PathHash)
+		{
+			AddSuccessor(Source, AssetPath, PathHash);
+		}
+	}
+
+	FEntry& Entry = Table[PathHash & TableMask];
+	if (Entry.PathHash != PathHash)
+	{
+		Entry = FEntry();
+		Entry.PathHash = PathHash;
+	}
+
+	// Halve the statistics before they saturate, which also lets old patterns fade out.
+	if (Entry.Occurrences == MAX_uint16)
+	{
+		Entry.Occurrences /= 2;
+		for (FSuccessor& Successor : Entry.Successors)
+		{
+			Successor.Count /= 2;
+		}
+	}
+	Entry.Occurrences++;
+
+	Window[NextWindowSlot].PathHash = PathHash;
+	Window[NextWindowSlot].Time = Now;
+	NextWindowSlot = (NextWindowSlot + 1) % WindowSize;
+
+	if (Entry.Occurrences < MinOccurrences) return;
+
+	const float MinCount = MinConfidence * Entry.Occurrences;
+	for (const FSuccessor& Successor : Entry.Successors)
+	{
+		if (Successor.Count > 0 && Successor.Count >= MinCount)
+		{
+			OutPredictions.Add(Successor.Path);
+		}
+	}
+}
+
+void FAssetStreamingPredictor::AddSuccessor(FEntry& Entry, const FSoftObjectPath& Path, const uint32 PathHash)
+{
+	FSuccessor* LeastFrequent = &Entry.Successors[0];
+	for (FSuccessor& Successor : Entry.Successors)
+	{
+		if (Successor.Count > 0 && Successor.PathHash == PathHash)
+		{
+			if (Successor.Count < MAX_uint16) Successor.Count++;
+			return;
+		}
+
+		if (Successor.Count < LeastFrequent->Count) LeastFrequent = &Successor;
+	}
+
+	LeastFrequent->Path = Path;
+	LeastFrequent->PathHash = PathHash;
+	LeastFrequent->Count = 1;
+}
@@ -0,0 +1,94 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingReplayCommandlet.h"
+#include "AssetStreamingTrace.h"
+#include "AssetStreamingTraceReplay.h"
+#include "Misc/Parse.h"
+#include "SimpleAssetStreaming.h"
+
+UAssetStreamingReplayCommandlet::UAssetStreamingReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UAssetStreamingReplayCommandlet::Main(const FString& Params)
+{
+	FString Filename = FAssetStreamingTrace::GetDefaultFilename();
+	FParse::Value(*Params, TEXT("Trace="), Filename);
+
+	FAssetStreamingTrace Trace;
+	if (!Trace.Load(Filename))
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Could not read asset streaming trace '%s'."), *Filename);
+		return 1;
+	}
+
+	const TArray<float> UnloadDelays = ParseValues(Params, TEXT("UnloadDelays="), { 0.0f, 5.0f, 30.0f });
+	const TArray<float> CacheBudgetsMB = ParseValues(Params, TEXT("CacheBudgetsMB="), { 0.0f });
+
+	FAssetStreamingReplayLatency Latency;
+	FParse::Value(*Params, TEXT("LatencyMs="), Latency.BaseMs);
+	FParse::Value(*Params, TEXT("BandwidthMBps="), Latency.MegabytesPerSecond);
+
+	UE_LOG(LogAssetStreaming, Display, TEXT("Replaying %s events over %s assets from '%s', loads taking %.1f ms plus their size at %.1f MB/s."),
+		*FString::FromInt(Trace.Num()), *FString::FromInt(Trace.GetAssetPaths().Num()), *Filename, Latency.BaseMs, Latency.MegabytesPerSecond);
+	UE_LOG(LogAssetStreaming, Display, TEXT("%12s %12s %14s %10s %10s %10s %14s"), TEXT("Delay (s)"), TEXT("Cache (MB)"), TEXT("Peak (MB)"), TEXT("Loads"), TEXT("Reloads"), TEXT("Hit rate"), TEXT("Avg wait (ms)"));
+
+	for (const float UnloadDelay : UnloadDelays)
+	{
+		for (const float CacheBudgetMB : CacheBudgetsMB)
+		{
+			const FAssetStreamingReplayPolicy Policy(FMath::Max(UnloadDelay, 0.0f), static_cast<int64>(FMath::Max(CacheBudgetMB, 0.0f) * 1024.0 * 1024.0));
+			const FAssetStreamingReplayResult Result = FAssetStreamingTraceReplay::Run(Trace, Policy, Latency);
+
+			UE_LOG(LogAssetStreaming, Display, TEXT("%12.1f %12.1f %14.2f %10u %10u %9.1f%% %14.2f"),
+				Policy.UnloadDelaySeconds, CacheBudgetMB, Result.PeakTrackedBytes / (1024.0 * 1024.0), Result.NumLoads, Result.NumReloads, 100.0f * Result.GetHitRate(), Result.GetAverageWaitMs());
+		}
+	}
+
+	return 0;
+}
+
+TArray<float> UAssetStreamingReplayCommandlet::ParseValues(const FString& Params, const TCHAR* Name, const TArray<float>& DefaultValues)
+{
+	FString ValueList;
+	if (!FParse::Value(*Params, Name, ValueList, false)) return DefaultValues;
+
+	TArray<FString> ValueStrings;
+	ValueList.ParseIntoArray(ValueStrings, TEXT(","));
+
+	TArray<float> Values;
+	for (const FString& ValueString : ValueStrings)
+	{
+		Values.Add(FCString::Atof(*ValueString));
+	}
+
+	return Values.Num() > 0 ? Values : DefaultValues;
+}
@@ -0,0 +1,95 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingSpatialHash.h"
+
+void FAssetStreamingSpatialHash::SetCellSize(const float InCellSize)
+{
+	checkf(NumIds == 0, TEXT("Cannot change the cell size of a spatial hash that isn't empty."));
+	checkf(InCellSize > 0.0f, TEXT("Spatial hash cells must have a positive size."));
+	CellSize = InCellSize;
+}
+
+FIntPoint FAssetStreamingSpatialHash::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void FAssetStreamingSpatialHash::Add(const int32 Id, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Id);
+	NumIds++;
+}
+
+void FAssetStreamingSpatialHash::Remove(const int32 Id, const FIntPoint& Cell)
+{
+	TArray<int32>* Ids = Cells.Find(Cell);
+	if (!Ids || Ids->RemoveSingleSwap(Id, false) == 0) return;
+
+	NumIds--;
+	if (Ids->Num() == 0) Cells.Remove(Cell);
+}
+
+void FAssetStreamingSpatialHash::Query(const FVector& Center, const float Radius, TArray<int32>& OutIds) const
+{
+	const FIntPoint Min = GetCell(Center - FVector(Radius));
+	const FIntPoint Max = GetCell(Center + FVector(Radius));
+
+	// Large radii cover more cells than are occupied, visit the occupied ones instead.
+	const int64 NumCoveredCells = static_cast<int64>(Max.X - Min.X + 1) * (Max.Y - Min.Y + 1);
+	if (NumCoveredCells > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			if (Cell.Key.X >= Min.X && Cell.Key.X <= Max.X && Cell.Key.Y >= Min.Y && Cell.Key.Y <= Max.Y)
+			{
+				OutIds.Append(Cell.Value);
+			}
+		}
+		return;
+	}
+
+	for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+	{
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			if (const TArray<int32>* Ids = Cells.Find(FIntPoint(X, Y)))
+			{
+				OutIds.Append(*Ids);
+			}
+		}
+	}
+}
+
+SIZE_T FAssetStreamingSpatialHash::GetAllocatedSize() const
+{
+	SIZE_T Size = Cells.GetAllocatedSize();
+	for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+	{
+		Size += Cell.Value.GetAllocatedSize();
+	}
+	return Size;
+}
@@ -0,0 +1,75 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingStartupManifest.h"
+#include "AssetStreamingFileFormat.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "SimpleAssetStreaming.h"
+
+FString FAssetStreamingStartupManifest::GetDefaultFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AssetStreaming") / TEXT("StartupManifest.bin");
+}
+
+bool FAssetStreamingStartupManifest::Save(const FString& Filename, const TArray<FSoftObjectPath>& AssetPaths)
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	FAssetStreamingFileFormat::SaveHeader(Writer, Magic, Version);
+	FAssetStreamingFileFormat::SaveCount(Writer, AssetPaths.Num());
+	FAssetStreamingFileFormat::SaveAssetPaths(Writer, AssetPaths);
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FAssetStreamingStartupManifest::Load(const FString& Filename, TArray<FSoftObjectPath>& OutAssetPaths)
+{
+	OutAssetPaths.Reset();
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent)) return false;
+
+	FMemoryReader Reader(Data);
+
+	int32 NumAssetPaths = 0;
+	if (!FAssetStreamingFileFormat::LoadHeader(Reader, Magic, Version) || !FAssetStreamingFileFormat::LoadCount(Reader, FAssetStreamingFileFormat::MaxAssetPaths, NumAssetPaths))
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Ignoring invalid startup manifest '%s'."), *Filename);
+		return false;
+	}
+
+	if (!FAssetStreamingFileFormat::LoadAssetPaths(Reader, NumAssetPaths, OutAssetPaths))
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Ignoring truncated startup manifest '%s'."), *Filename);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,62 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingStats.h"
+
+DEFINE_STAT(STAT_AssetStreaming_StreamAsset);
+DEFINE_STAT(STAT_AssetStreaming_ReleaseAssets);
+DEFINE_STAT(STAT_AssetStreaming_FinalUnloadAssets);
+DEFINE_STAT(STAT_AssetStreaming_Pump);
+DEFINE_STAT(STAT_AssetStreaming_EvaluateProximity);
+DEFINE_STAT(STAT_AssetStreaming_WaitForRequests);
+DEFINE_STAT(STAT_AssetStreaming_ExpandDependencies);
+
+DEFINE_STAT(STAT_AssetStreaming_TrackedAssets);
+DEFINE_STAT(STAT_AssetStreaming_KeepAliveHandles);
+DEFINE_STAT(STAT_AssetStreaming_PendingUnloads);
+DEFINE_STAT(STAT_AssetStreaming_WarmCachedAssets);
+DEFINE_STAT(STAT_AssetStreaming_InFlightLoads);
+DEFINE_STAT(STAT_AssetStreaming_StreamingComponents);
+DEFINE_STAT(STAT_AssetStreaming_ResidentMB);
+DEFINE_STAT(STAT_AssetStreaming_UnreachableMB);
+DEFINE_STAT(STAT_AssetStreaming_ExcludedAssets);
+DEFINE_STAT(STAT_AssetStreaming_StaleRequests);
+DEFINE_STAT(STAT_AssetStreaming_StalePinnedMB);
+DEFINE_STAT(STAT_AssetStreaming_ExpandedDependencies);
+DEFINE_STAT(STAT_AssetStreaming_Prefetches);
+DEFINE_STAT(STAT_AssetStreaming_PrefetchAccuracy);
+DEFINE_STAT(STAT_AssetStreaming_PrefetchWastedMB);
+DEFINE_STAT(STAT_AssetStreaming_PendingCompletions);
+DEFINE_STAT(STAT_AssetStreaming_UnloadBacklog);
+DEFINE_STAT(STAT_AssetStreaming_PumpFramesBehind);
+DEFINE_STAT(STAT_AssetStreaming_HitRate);
+DEFINE_STAT(STAT_AssetStreaming_AverageLatency);
+
+CSV_DEFINE_CATEGORY(AssetStreaming, true);
+
+#if ASSET_STREAMING_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(AssetStreamingChannel);
+#endif
@@ -0,0 +1,90 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+// Unreal Insights trace channels are only available since 4.26.
+// CPUPROFILERTRACE_ENABLED is defined by the CPU profiler trace header, which must be included before it is tested.
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 26
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#define ASSET_STREAMING_TRACE_ENABLED CPUPROFILERTRACE_ENABLED
+#else
+#define ASSET_STREAMING_TRACE_ENABLED 0
+#endif
+
+DECLARE_STATS_GROUP(TEXT("AssetStreaming"), STATGROUP_AssetStreaming, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Stream Asset"), STAT_AssetStreaming_StreamAsset, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Release Assets"), STAT_AssetStreaming_ReleaseAssets, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Final Unload Assets"), STAT_AssetStreaming_FinalUnloadAssets, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pump"), STAT_AssetStreaming_Pump, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Evaluate Proximity"), STAT_AssetStreaming_EvaluateProximity, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Wait For Requests"), STAT_AssetStreaming_WaitForRequests, STATGROUP_AssetStreaming, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Expand Dependencies"), STAT_AssetStreaming_ExpandDependencies, STATGROUP_AssetStreaming, );
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Tracked Assets"), STAT_AssetStreaming_TrackedAssets, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Keep-Alive Handles"), STAT_AssetStreaming_KeepAliveHandles, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Unloads"), STAT_AssetStreaming_PendingUnloads, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Warm Cached Assets"), STAT_AssetStreaming_WarmCachedAssets, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("In-Flight Loads"), STAT_AssetStreaming_InFlightLoads, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Streaming Components"), STAT_AssetStreaming_StreamingComponents, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Resident Assets (MB)"), STAT_AssetStreaming_ResidentMB, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Unloaded Awaiting GC (MB)"), STAT_AssetStreaming_UnreachableMB, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Excluded Assets"), STAT_AssetStreaming_ExcludedAssets, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Stale Requests"), STAT_AssetStreaming_StaleRequests, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Stale Pinned (MB)"), STAT_AssetStreaming_StalePinnedMB, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Expanded Dependencies"), STAT_AssetStreaming_ExpandedDependencies, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Prefetches"), STAT_AssetStreaming_Prefetches, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Prefetch Accuracy (%)"), STAT_AssetStreaming_PrefetchAccuracy, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Prefetch Wasted (MB)"), STAT_AssetStreaming_PrefetchWastedMB, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Completions"), STAT_AssetStreaming_PendingCompletions, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Unload Backlog"), STAT_AssetStreaming_UnloadBacklog, STATGROUP_AssetStreaming, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pump Frames Behind"), STAT_AssetStreaming_PumpFramesBehind, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Already Loaded Hit Rate (%)"), STAT_AssetStreaming_HitRate, STATGROUP_AssetStreaming, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Average Load Latency (ms)"), STAT_AssetStreaming_AverageLatency, STATGROUP_AssetStreaming, );
+
+CSV_DECLARE_CATEGORY_EXTERN(AssetStreaming);
+
+#if ASSET_STREAMING_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(AssetStreamingChannel);
+
+// Times a scope in the stats system, the CSV profiler and the asset streaming trace channel.
+#define ASSET_STREAMING_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_AssetStreaming_##Name); \
+	CSV_SCOPED_TIMING_STAT(AssetStreaming, Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(AssetStreaming_##Name, AssetStreamingChannel)
+#else
+// Times a scope in the stats system and the CSV profiler.
+#define ASSET_STREAMING_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_AssetStreaming_##Name); \
+	CSV_SCOPED_TIMING_STAT(AssetStreaming, Name)
+#endif
@@ -25,288 +25,2876 @@ SOFTWARE.
 */
 
 #include "AssetStreamingSubsystem.h"
+#include "AssetRegistryModule.h"
 #include "AssetStreamingCallback.h"
+#include "AssetStreamingComponent.h"
+#include "AssetStreamingStartupManifest.h"
+#include "AssetStreamingStats.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Async/Future.h"
+#include "LatentActions.h"
+#include "Misc/CoreDelegates.h"
 #include "UObject/SoftObjectPtr.h"
+#include "UObject/UObjectGlobals.h"
 #include "SimpleAssetStreaming.h"
 
+// State shared by the delegates of a batch request, used to dispatch per-asset and whole-batch notifications.
+struct FAssetStreamingBatch
+{
+	TArray<TSoftObjectPtr<UObject>> Assets;
+
+	// Whether each asset was already loaded when the batch was requested. Excluded assets count as loaded.
+	TBitArray<> WasAlreadyLoaded;
+
+	// Whether the class of each asset is excluded in the current net mode. Excluded assets aren't loaded.
+	TBitArray<> Excluded;
+
+	// Whether the callback has already been notified of each asset.
+	TBitArray<> Notified;
+
+	// When the batch was requested, used to measure the load latency.
+	double RequestTime;
+
+	// Whether the batch handle is counted as an in-flight load.
+	bool bIsInFlight;
+
+	TScriptInterface<IAssetStreamingCallback> Callback;
+
+	// Native callbacks, called instead of the interface. Only set by native requests.
+	FAssetLoadedFunction OnAssetLoaded;
+	FAssetRequestLoadedFunction OnRequestLoaded;
+
+	// The request the batch belongs to. Native callbacks are skipped once it is released.
+	FAssetStreamingRequestHandle RequestHandle;
+};
+
+// Resolves the future of a native request, with no assets if the request is cancelled before it is loaded.
+struct FAssetStreamingPromise
+{
+	FAssetStreamingPromise()
+		: bIsSet(false)
+	{}
+
+	~FAssetStreamingPromise()
+	{
+		SetValue(TArray<UObject*>());
+	}
+
+	void SetValue(const TArray<UObject*>& LoadedAssets)
+	{
+		if (bIsSet) return;
+
+		bIsSet = true;
+		Promise.SetValue(LoadedAssets);
+	}
+
+	TPromise<TArray<UObject*>> Promise;
+
+	bool bIsSet;
+};
+
+// Latent Blueprint node waiting for the future of a barrier.
+class FAssetStreamingWaitAction : public FPendingLatentAction
+{
+public:
+
+	FAssetStreamingWaitAction(TFuture<bool>&& InFuture, bool& bInOutCompleted, const FLatentActionInfo& LatentInfo)
+		: Future(MoveTemp(InFuture))
+		, bOutCompleted(bInOutCompleted)
+		, ExecutionFunction(LatentInfo.ExecutionFunction)
+		, OutputLink(LatentInfo.Linkage)
+		, CallbackTarget(LatentInfo.CallbackTarget)
+	{}
+
+	virtual void UpdateOperation(FLatentResponse& Response) override
+	{
+		if (!Future.IsReady()) return;
+
+		bOutCompleted = Future.Get();
+		Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+	}
+
+private:
+
+	TFuture<bool> Future;
+
+	bool& bOutCompleted;
+
+	FName ExecutionFunction;
+
+	int32 OutputLink;
+
+	FWeakObjectPtr CallbackTarget;
+};
+
 // Singleton instance initialization.
 UAssetStreamingSubsystem* UAssetStreamingSubsystem::Instance = nullptr;
 
-void UAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+// Lists the owners holding the most streamed memory, i.e. "AssetStreaming.MemoryReport 20".
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice MemoryReportCommand(
+	TEXT("AssetStreaming.MemoryReport"),
+	TEXT("Lists the owners holding the most memory through their asset streaming requests. Takes the number of owners to list, 10 by default."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UAssetStreamingSubsystem* Subsystem = UAssetStreamingSubsystem::Get();
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("The asset streaming subsystem isn't initialized."));
+			return;
+		}
+
+		TArray<FAssetStreamingOwnerMemory> Owners;
+		Subsystem->GetTopMemoryOwners(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10, Owners);
+
+		Ar.Logf(TEXT("Tracked assets: %.2f MB"), Subsystem->GetTrackedResidentBytes() / (1024.0 * 1024.0));
+		for (const FAssetStreamingOwnerMemory& Owner : Owners)
+		{
+			Ar.Logf(TEXT("  %-40s %10.2f MB  %6d request(s)  %6d asset(s)"), *Owner.Owner.ToString(), Owner.ResidentBytes / (1024.0 * 1024.0), Owner.NumRequests, Owner.NumAssets);
+		}
+	}));
+
+// Lists the requests that were likely never released, i.e. "AssetStreaming.AuditRequests 600".
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice AuditRequestsCommand(
+	TEXT("AssetStreaming.AuditRequests"),
+	TEXT("Lists the asset streaming requests older than an age, or whose owner was garbage collected. Takes the age in seconds, 300 by default."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UAssetStreamingSubsystem* Subsystem = UAssetStreamingSubsystem::Get();
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("The asset streaming subsystem isn't initialized."));
+			return;
+		}
+
+		TArray<FAssetStreamingStaleRequests> StaleRequests;
+		const int32 NumStaleRequests = Subsystem->FindStaleRequests(Args.Num() > 0 ? FCString::Atof(*Args[0]) : 300.0f, StaleRequests);
+
+		Ar.Logf(TEXT("Stale requests: %d"), NumStaleRequests);
+		for (const FAssetStreamingStaleRequests& Group : StaleRequests)
+		{
+			Ar.Logf(TEXT("  %-32s %-40s %6d request(s)  oldest %8.0f s  %10.2f MB pinned  %10.2f MB referenced%s"), *Group.Owner.ToString(), *Group.Callsite.ToString(),
+				Group.NumRequests, Group.OldestAgeSeconds, Group.PinnedBytes / (1024.0 * 1024.0), Group.ResidentBytes / (1024.0 * 1024.0), Group.bOwnerDestroyed ? TEXT("  (owner destroyed)") : TEXT(""));
+		}
+	}));
+
+// Records a trace of the session to replay offline, i.e. "AssetStreaming.Trace Start" then "AssetStreaming.Trace Stop".
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice TraceCommand(
+	TEXT("AssetStreaming.Trace"),
+	TEXT("Starts or stops recording an asset streaming trace. Takes 'Start', or 'Stop' followed by an optional file to write the trace to."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		UAssetStreamingSubsystem* Subsystem = UAssetStreamingSubsystem::Get();
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("The asset streaming subsystem isn't initialized."));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0] == TEXT("Start"))
+		{
+			Subsystem->StartTraceRecording();
+			Ar.Log(TEXT("Started recording an asset streaming trace."));
+		}
+		else if (Args.Num() > 0 && Args[0] == TEXT("Stop"))
+		{
+			Ar.Log(Subsystem->StopTraceRecording(Args.Num() > 1 ? Args[1] : FString()) ? TEXT("Asset streaming trace written.") : TEXT("No asset streaming trace was written."));
+		}
+		else
+		{
+			Ar.Log(TEXT("Usage: AssetStreaming.Trace Start|Stop [Filename]"));
+		}
+	}));
+
+void UAssetStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Set the singleton instance to this instance.
+	Instance = this;
+
+	// Sanity check on the asset unload delay.
+	if (UnloadDelaySeconds < 0.0f)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("UnloadDelaySeconds cannot be a negative number. Setting it to 5 seconds."));
+		UnloadDelaySeconds = 5.0f;
+	}
+
+	if (StaleRequestAgeSeconds < 0.0f)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("StaleRequestAgeSeconds cannot be a negative number. Disabling the stale request audits."));
+		StaleRequestAgeSeconds = 0.0f;
+	}
+
+	if (StaleRequestAuditIntervalSeconds <= 0.0f)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("StaleRequestAuditIntervalSeconds must be a positive number. Setting it to 60 seconds."));
+		StaleRequestAuditIntervalSeconds = 60.0f;
+	}
+	NextStaleRequestAuditTime = FPlatformTime::Seconds() + StaleRequestAuditIntervalSeconds;
+
+	if (MaxExpandedDependencies <= 0)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("MaxExpandedDependencies must be a positive number. Setting it to 512 dependencies."));
+		MaxExpandedDependencies = 512;
+	}
+
+	if (LoadSubmissionWindowSeconds < 0.0f)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("LoadSubmissionWindowSeconds cannot be a negative number. Setting it to 0 seconds."));
+		LoadSubmissionWindowSeconds = 0.0f;
+	}
+
+	if (ProximityCellSize <= 0.0f)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("ProximityCellSize must be a positive number. Setting it to 10000 units."));
+		ProximityCellSize = 10000.0f;
+	}
+	ProximityGrid.SetCellSize(ProximityCellSize);
+
+	// Class filters read the class of requested assets from the asset registry.
+	if (ClassFilters.Num() > 0)
+	{
+		AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	}
+
+	InitializeClassPolicies();
+
+	// Watermarks are checked in ascending order, only positive ones make sense.
+	MemoryWatermarksBytes.RemoveAll([](const int64 Watermark) { return Watermark <= 0; });
+	MemoryWatermarksBytes.Sort();
+
+	// Preload what the previous session requested first, before gameplay code asks for it one asset at a time.
+	if (bPreloadStartupManifest)
+	{
+		StartStartupPreload();
+	}
+
+	// Learn which assets follow each other, and prefetch them once the patterns are confident enough.
+	if (bEnablePredictivePrefetch)
+	{
+		if (PredictorTableSize <= 0)
+		{
+			UE_LOG(LogAssetStreaming, Error, TEXT("PredictorTableSize must be a positive number. Setting it to 4096 entries."));
+			PredictorTableSize = 4096;
+		}
+
+		if (PredictorMinConfidence <= 0.0f || PredictorMinConfidence > 1.0f)
+		{
+			UE_LOG(LogAssetStreaming, Error, TEXT("PredictorMinConfidence must be between 0 and 1. Setting it to 0.5."));
+			PredictorMinConfidence = 0.5f;
+		}
+
+		Predictor.Initialize(PredictorTableSize, PredictorWindowSeconds);
+	}
+
+	if (bRecordStartupManifest)
+	{
+		bIsRecordingStartupManifest = true;
+		StartupRecordEndTime = FPlatformTime::Seconds() + StartupManifestRecordSeconds;
+	}
+
+	if (bRecordTrace)
+	{
+		if (MaxTraceEvents <= 0)
+		{
+			UE_LOG(LogAssetStreaming, Error, TEXT("MaxTraceEvents must be a positive number. Setting it to 1048576 events."));
+			MaxTraceEvents = 1048576;
+		}
+
+		StartTraceRecording();
+	}
+
+	// Flush the warm cache when the platform asks us to free memory.
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &UAssetStreamingSubsystem::HandleMemoryTrim);
+
+	// Release the requests of owners that were destroyed without releasing them, and count what the collection reclaimed.
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UAssetStreamingSubsystem::HandlePostGarbageCollect);
+
+	// Process the unload queue once per frame.
+	TickHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UAssetStreamingSubsystem::Tick));
+}
+
+void UAssetStreamingSubsystem::Deinitialize()
+{
+	FTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	QueuedOperations.Empty();
+	QueuedRequestHandles.Reset();
+	PendingLoads.Empty();
+	PendingLoadsScratch.Empty();
+
+	// Sessions shorter than the recording window still record what they requested.
+	if (bIsRecordingStartupManifest)
+	{
+		FinishStartupRecording();
+	}
+	ReleaseStartupPreload();
+
+	if (bIsRecordingTrace)
+	{
+		StopTraceRecording();
+	}
+
+	if (Predictor.IsInitialized())
+	{
+		UE_LOG(LogAssetStreaming, Log, TEXT("Predictive prefetch: %u issued, %u hits, %u wasted (%lld bytes), %.1f%% accuracy."),
+			PrefetchStats.NumIssued, PrefetchStats.NumHits, PrefetchStats.NumWasted, PrefetchStats.WastedBytes, 100.0f * PrefetchStats.GetAccuracy());
+	}
+	DropPrefetches();
+
+	// Components still registered can't reach us anymore.
+	for (const FAssetStreamingProximityEntry& Entry : ProximityEntries)
+	{
+		if (UAssetStreamingComponent* Component = Entry.Component.Get())
+		{
+			Component->StreamingSubsystem.Reset();
+			Component->ProximityIndex = INDEX_NONE;
+			Component->bIsStreamingAssets = false;
+		}
+	}
+	ProximityEntries.Empty();
+	ActiveProximityEntries.Empty();
+	ProximityCandidates.Empty();
+	NextProximityCandidate = 0;
+
+	// Nothing will complete anymore.
+	for (const FAssetStreamingBarrier& Barrier : Barriers)
+	{
+		Barrier.Promise->SetValue(false);
+	}
+	Barriers.Empty();
+
+	// Callbacks still waiting for the pump are dropped, resolving the futures of native requests without assets.
+	PendingCompletions.Empty();
+	NextCompletionIndex = 0;
+	ExpiredUnloads.Empty();
+	NextExpiredUnloadIndex = 0;
+
+	if (LatencyHistogram.GetNumSamples() > 0)
+	{
+		UE_LOG(LogAssetStreaming, Log, TEXT("Asset load latency: %s"), *LatencyHistogram.ToString());
+	}
+
+	Instance = nullptr;
+}
+
+bool UAssetStreamingSubsystem::Tick(float DeltaTime)
+{
+	// Submit what other threads queued since the last tick.
+	ProcessQueuedOperations();
+
+	// Then the new loads of every caller, sorted together.
+	if (PendingLoads.Num() > 0 && FPlatformTime::Seconds() >= PendingLoadsSubmitTime)
+	{
+		SubmitPendingLoads();
+	}
+
+	if (ProximityEntries.Num() > 0)
+	{
+		EvaluateProximity();
+	}
+
+	if (bIsRecordingStartupManifest && FPlatformTime::Seconds() >= StartupRecordEndTime)
+	{
+		FinishStartupRecording();
+	}
+
+	if (StartupPreloadHandle.IsValid() && FPlatformTime::Seconds() >= StartupPreloadEndTime)
+	{
+		ReleaseStartupPreload();
+	}
+
+	// Keep what was recorded rather than growing the trace without bounds.
+	if (bIsRecordingTrace && Trace.Num() >= MaxTraceEvents)
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Asset streaming trace reached %s events, stopping the recording."), *FString::FromInt(Trace.Num()));
+		StopTraceRecording();
+	}
+
+	if (Prefetches.Num() > 0)
+	{
+		ExpirePrefetches();
+	}
+
+	// Leaked requests grow memory slowly over long sessions, a look every now and then is enough to find them.
+	if (StaleRequestAgeSeconds > 0.0f && FPlatformTime::Seconds() >= NextStaleRequestAuditTime)
+	{
+		NextStaleRequestAuditTime = FPlatformTime::Seconds() + StaleRequestAuditIntervalSeconds;
+		AuditStaleRequests();
+	}
+
+	// Broadcast from the tick rather than from the loads, so that listeners can safely request or release assets.
+	if (MemoryWatermarksBytes.Num() > 0)
+	{
+		UpdateMemoryWatermarks();
+	}
+
+	// Expired unloads are carried over with the leftovers of the previous frames.
+	UnloadQueue.PopExpired(FPlatformTime::Seconds(), ExpiredUnloads);
+
+	if (NextCompletionIndex < PendingCompletions.Num() || NextExpiredUnloadIndex < ExpiredUnloads.Num())
+	{
+		Pump();
+	}
+
+	// After the pump, so that waiters see the loaded callbacks of their requests first.
+	if (Barriers.Num() > 0)
+	{
+		UpdateBarriers();
+	}
+
+	// Unloaded assets only leave memory once they're garbage collected. Don't wait for the next periodic collection after large unload waves.
+	const bool bIsTrimUnloaded = bIsTrimReclaimPending && NextExpiredUnloadIndex >= ExpiredUnloads.Num();
+	if (ReclaimThresholdBytes > 0 && (UnreachableBytes >= ReclaimThresholdBytes || (bIsTrimUnloaded && UnreachableBytes > 0)))
+	{
+		RequestReclaim();
+	}
+
+	if (bIsTrimUnloaded)
+	{
+		bIsTrimReclaimPending = false;
+	}
+
+	UpdateStats();
+
+	// Keep ticking.
+	return true;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const TArray<TSoftObjectPtr<>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	// Invalidate the request handle if there is nothing to stream.
+	if (AssetsToStream.Num() == 0)
+	{
+		OutRequestHandle.Invalidate();
+		return false;
+	}
+
+	// Assign a request slot to the request.
+	OutRequestHandle = AllocateRequest(Priority, Options);
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Request to stream %s asset(s) received. Request handle: %s"), *FString::FromInt(AssetsToStream.Num()), *OutRequestHandle.ToString());
+	for (const TSoftObjectPtr<UObject>& Asset : AssetsToStream)
+	{
+		StreamOrQueueAsset(Asset, OutRequestHandle, AssetLoadedCallback, Priority);
+	}
+
+	if (bExpandDependencies)
+	{
+		StreamDependencies(AssetsToStream, OutRequestHandle, Priority);
+	}
+
+	// Any asset streaming operation that passes assertions but still isn't valid will cause the request handle to invalidate.
+	return OutRequestHandle.IsValid();
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	// Assign a request slot to the request.
+	OutRequestHandle = AllocateRequest(Priority, Options);
+	StreamOrQueueAsset(AssetToStream, OutRequestHandle, AssetLoadedCallback, Priority);
+
+	if (bExpandDependencies)
+	{
+		StreamDependencies(MakeArrayView(&AssetToStream, 1), OutRequestHandle, Priority);
+	}
+
+	return OutRequestHandle.IsValid();
+}
+
+bool UAssetStreamingSubsystem::RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	// Invalidate the request handle if there is nothing to stream.
+	if (AssetsToStream.Num() == 0)
+	{
+		OutRequestHandle.Invalidate();
+		return false;
+	}
+
+	// Assign a request slot to the request.
+	OutRequestHandle = AllocateRequest(Priority, Options);
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Request to stream a batch of %s asset(s) received. Request handle: %s"), *FString::FromInt(AssetsToStream.Num()), *OutRequestHandle.ToString());
+
+	TSharedRef<FAssetStreamingBatch> Batch = MakeShared<FAssetStreamingBatch>();
+	Batch->Callback = AssetLoadedCallback;
+
+	if (!StreamAssetBatch(AssetsToStream, OutRequestHandle, Batch, Priority))
+	{
+		FreeRequest(OutRequestHandle);
+		OutRequestHandle.Invalidate();
+	}
+	else if (bExpandDependencies)
+	{
+		StreamDependencies(AssetsToStream, OutRequestHandle, Priority);
+	}
+
+	return OutRequestHandle.IsValid();
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FAssetStreamingRequestHandle& OutRequestHandle, FAssetRequestLoadedFunction&& OnRequestLoaded, const EAssetStreamingPriority Priority, FAssetLoadedFunction&& OnAssetLoaded, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	// Invalidate the request handle if there is nothing to stream.
+	if (AssetsToStream.Num() == 0)
+	{
+		OutRequestHandle.Invalidate();
+		return false;
+	}
+
+	// Assign a request slot to the request.
+	OutRequestHandle = AllocateRequest(Priority, Options);
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Native request to stream %s asset(s) received. Request handle: %s"), *FString::FromInt(AssetsToStream.Num()), *OutRequestHandle.ToString());
+
+	// Native requests are always streamed as a batch, the completion is called once for the whole request.
+	TSharedRef<FAssetStreamingBatch> Batch = MakeShared<FAssetStreamingBatch>();
+	Batch->OnAssetLoaded = MoveTemp(OnAssetLoaded);
+	Batch->OnRequestLoaded = MoveTemp(OnRequestLoaded);
+	Batch->RequestHandle = OutRequestHandle;
+
+	if (!StreamAssetBatch(AssetsToStream, OutRequestHandle, Batch, Priority))
+	{
+		FreeRequest(OutRequestHandle);
+		OutRequestHandle.Invalidate();
+	}
+	else if (bExpandDependencies)
+	{
+		StreamDependencies(AssetsToStream, OutRequestHandle, Priority);
+	}
+
+	return OutRequestHandle.IsValid();
+}
+
+TFuture<TArray<UObject*>> UAssetStreamingSubsystem::RequestAssetStreamingAsync(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	// The promise is owned by the completion. If the request fails or is cancelled, destroying the completion resolves the future.
+	TSharedRef<FAssetStreamingPromise> Promise = MakeShared<FAssetStreamingPromise>();
+	TFuture<TArray<UObject*>> Future = Promise->Promise.GetFuture();
+
+	RequestAssetStreaming(AssetsToStream, OutRequestHandle, [Promise](const TArray<UObject*>& LoadedAssets) { Promise->SetValue(LoadedAssets); }, Priority, nullptr, Options);
+
+	return Future;
+}
+
+bool UAssetStreamingSubsystem::ReleaseAssets(FAssetStreamingRequestHandle& RequestHandle)
+{
+	CheckThis();
+	checkf(IsInGameThread(), TEXT("Assets can only be released on the game thread. Use EnqueueReleaseAssets() from other threads."));
+	ASSET_STREAMING_SCOPE(ReleaseAssets);
+
+	if (!RequestHandle.IsValid())
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to release assets using an invalid request handle."));
+		return false;
+	}
+
+	// Requests queued by other threads are released through the handle of their request slot.
+	if (RequestHandle.IsQueued())
+	{
+		FAssetStreamingRequestHandle SlotHandle = ResolveRequestHandle(RequestHandle);
+
+		// Requests released in bulk forget their queued handle, releasing it again isn't a mistake.
+		if (!SlotHandle.IsValid())
+		{
+			UE_LOG(LogAssetStreaming, Verbose, TEXT("Queued request '%s' was already released."), *RequestHandle.ToString());
+			RequestHandle.Invalidate();
+			return false;
+		}
+
+		RequestHandle.Invalidate();
+		return ReleaseAssets(SlotHandle);
+	}
+
+	FAssetStreamingRequest* Request = FindRequest(RequestHandle);
+	if (!Request)
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to release assets using handle '%s' but it leads to no assets."), *RequestHandle.ToString());
+		RequestHandle.Invalidate();
+		return false;
+	}
+
+	// Records whose references drop to zero, reused between releases to avoid allocating.
+	ReleasedRecords.Reset();
+	ReleaseRequest(RequestHandle);
+
+	if (ReleasedRecords.Num() == 0)
+	{
+		UE_LOG(LogAssetStreaming, Verbose, TEXT("Finished releasing assets without any need for unloading. Request handle: '%s'"), *RequestHandle.ToString());
+		RequestHandle.Invalidate();
+		return true;
+	}
+
+	UnloadReleasedRecords();
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Released %s assets. Request handle: '%s'"), *FString::FromInt(ReleasedRecords.Num()), *RequestHandle.ToString());
+	RequestHandle.Invalidate();
+
+	return true;
+}
+
+int32 UAssetStreamingSubsystem::ReleaseAllForOwner(const UObject* Owner)
+{
+	CheckThis();
+	checkf(IsInGameThread(), TEXT("Assets can only be released on the game thread. Use EnqueueReleaseAssets() from other threads."));
+
+	if (!Owner) return 0;
+
+	const int32 NumReleased = ReleaseRequestsIf([Owner](const FAssetStreamingRequest& Request) { return Request.Owner.Get() == Owner; });
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Released %s request(s) of owner '%s'."), *FString::FromInt(NumReleased), *Owner->GetName());
+	return NumReleased;
+}
+
+int32 UAssetStreamingSubsystem::ReleaseGroup(const FName Tag)
+{
+	CheckThis();
+	checkf(IsInGameThread(), TEXT("Assets can only be released on the game thread. Use EnqueueReleaseAssets() from other threads."));
+
+	if (Tag.IsNone()) return 0;
+
+	const int32 NumReleased = ReleaseRequestsIf([Tag](const FAssetStreamingRequest& Request) { return Request.Tag == Tag; });
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Released %s request(s) of group '%s'."), *FString::FromInt(NumReleased), *Tag.ToString());
+	return NumReleased;
+}
+
+int32 UAssetStreamingSubsystem::ReleaseRequestsIf(TFunctionRef<bool(const FAssetStreamingRequest&)> Predicate)
+{
+	ASSET_STREAMING_SCOPE(ReleaseAssets);
+
+	// References are dropped for every request first, so that assets shared between them are only scheduled for unloading once.
+	ReleasedRecords.Reset();
+	int32 NumReleased = 0;
+
+	for (int32 Index = 0; Index < Requests.Num(); Index++)
+	{
+		const FAssetStreamingRequest& Request = Requests[Index];
+		if (!Request.bIsActive || !Predicate(Request)) continue;
+
+		ReleaseRequest(FAssetStreamingRequestHandle(Index, Request.Generation));
+		NumReleased++;
+	}
+
+	if (ReleasedRecords.Num() > 0)
+	{
+		UnloadReleasedRecords();
+	}
+
+	return NumReleased;
+}
+
+void UAssetStreamingSubsystem::ReleaseRequest(const FAssetStreamingRequestHandle& SlotHandle)
+{
+	ReleaseRequestReferences(Requests[SlotHandle.Index]);
+
+	// Free the request slot, invalidating every handle to it, including the one it was queued with.
+	FreeRequest(SlotHandle);
+}
+
+void UAssetStreamingSubsystem::ReleaseRequestReferences(const FAssetStreamingRequest& Request)
+{
+	// Assets of a batch request share the same handle, we only need to check it once.
+	const FStreamableHandle* LastCheckedHandle = nullptr;
+
+	// Decrement the amount of references to each of these assets.
+	for (const FAssetHandlePair& Pair : Request.Assets)
+	{
+		checkf(Records.IsValidIndex(Pair.RecordIndex), TEXT("Attempted to release asset '%s' but we're not tracking it."), *Pair.Asset.GetAssetName());
+		FAssetStreamingRecord& Record = Records[Pair.RecordIndex];
+		checkf(!Pair.Asset.IsNull(), TEXT("Attempted to release null asset."));
+		checkf(Pair.Handle.Get(), TEXT("Asset handle is null."));
+
+		// If the handle of this asset doesn't keep any asset alive, cancel it immediately.
+		if (Pair.Handle.Get() != LastCheckedHandle)
+		{
+			LastCheckedHandle = Pair.Handle.Get();
+
+			if (!IsKeepAliveHandle(Pair.Handle, Pair.RecordIndex))
+			{
+				UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Handle to release isn't keep-alive, cancelling it."));
+				CancelHandle(Pair.Handle);
+			}
+			else
+			{
+				UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Handle to release is keep-alive, skipping it."));
+			}
+		}
+
+		// If we don't have any reference to this asset anymore, it'll need to be unloaded.
+		checkf(Record.RequestCount > 0, TEXT("Attempted to release asset '%s' but it has no references."), *Pair.Asset.GetAssetName());
+		if (--Record.RequestCount == 0)
+		{
+			ReleasedRecords.Add(Pair.RecordIndex);
+		}
+	}
+}
+
+void UAssetStreamingSubsystem::UnloadReleasedRecords()
+{
+	bool bHasCachedAssets = false;
+
+	for (const int32 RecordIndex : ReleasedRecords)
+	{
+		// Keep the assets in the warm cache of their policy if it's enabled. They will only be unloaded once evicted.
+		const int32 PolicyIndex = Records[RecordIndex].PolicyIndex;
+		if ((PolicyIndex == INDEX_NONE ? WarmCacheBudgetBytes : ClassPolicies[PolicyIndex].MaxWarmCacheBytes) > 0)
+		{
+			CacheReleasedAsset(RecordIndex);
+			bHasCachedAssets = true;
+		}
+		else
+		{
+			// Unload will happen after a delay, to verify that no other objects need the asset one more time.
+			ScheduleAssetUnloading(RecordIndex);
+		}
+	}
+
+	if (bHasCachedAssets)
+	{
+		EnforceWarmCacheBudget();
+	}
+}
+
+void UAssetStreamingSubsystem::HandlePostGarbageCollect()
+{
+	// Whatever was unloaded before the collection is gone now, whoever triggered it.
+	UnreachableBytes = 0;
+
+	if (!bReleaseRequestsOfDestroyedOwners) return;
+
+	// Owners that were destroyed without releasing their requests would pin their assets forever.
+	const int32 NumReleased = ReleaseRequestsIf([](const FAssetStreamingRequest& Request) { return !Request.Owner.IsExplicitlyNull() && !Request.Owner.IsValid(); });
+
+	if (NumReleased > 0)
+	{
+		UE_LOG(LogAssetStreaming, Log, TEXT("Released %s request(s) whose owner was garbage collected."), *FString::FromInt(NumReleased));
+	}
+}
+
+bool UAssetStreamingSubsystem::RaiseRequestPriority(const FAssetStreamingRequestHandle& RequestHandle, const EAssetStreamingPriority NewPriority)
+{
+	CheckThis();
+
+	FAssetStreamingRequest* Request = FindRequest(ResolveRequestHandle(RequestHandle));
+	if (!Request)
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to raise the priority of request '%s' but it leads to no assets."), *RequestHandle.ToString());
+		return false;
+	}
+
+	if (NewPriority <= Request->Priority)
+	{
+		UE_LOG(LogAssetStreaming, Verbose, TEXT("Request '%s' is already streamed at an equal or higher priority."), *RequestHandle.ToString());
+		return false;
+	}
+
+	Request->Priority = NewPriority;
+	const TAsyncLoadPriority LoadPriority = GetAsyncLoadPriority(NewPriority);
+
+	int32 RaisedAssetsCount = 0;
+	for (const FAssetHandlePair& Pair : Request->Assets)
+	{
+		if (Pair.Asset.IsValid() || !Pair.Handle.IsValid() || !Pair.Handle->IsLoadingInProgress()) continue;
+
+		// The streamable manager doesn't allow changing the priority of a handle.
+		// Requesting the package again makes the async loader raise the priority of the package that is already in flight.
+		LoadPackageAsync(Pair.Asset.ToSoftObjectPath().GetLongPackageName(), FLoadPackageAsyncDelegate(), LoadPriority);
+		RaisedAssetsCount++;
+	}
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Raised the priority of %s in-flight asset(s). Request handle: '%s'"), *FString::FromInt(RaisedAssetsCount), *RequestHandle.ToString());
+	return true;
+}
+
+FAssetStreamingRequestHandle UAssetStreamingSubsystem::EnqueueAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority, const bool bAsBatch, const FAssetStreamingRequestOptions& Options)
+{
+	CheckThis();
+
+	if (AssetsToStream.Num() == 0) return FAssetStreamingRequestHandle();
+
+	// Queued handles are unique sequence numbers, mapped to a request slot once the request is submitted.
+	FAssetStreamingQueuedOperation Operation;
+	Operation.Operation = bAsBatch ? EAssetStreamingOperation::BatchRequest : EAssetStreamingOperation::Request;
+	Operation.RequestHandle = FAssetStreamingRequestHandle(static_cast<uint32>(NextQueuedRequestIndex.Increment()), FAssetStreamingRequestHandle::QueuedGenerationBit);
+	Operation.Assets = AssetsToStream;
+	Operation.Callback = AssetLoadedCallback;
+	Operation.Priority = Priority;
+	Operation.Options = Options;
+
+	const FAssetStreamingRequestHandle RequestHandle = Operation.RequestHandle;
+	QueuedOperations.Enqueue(MoveTemp(Operation));
+
+	return RequestHandle;
+}
+
+void UAssetStreamingSubsystem::EnqueueReleaseAssets(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	CheckThis();
+
+	if (!RequestHandle.IsValid()) return;
+
+	FAssetStreamingQueuedOperation Operation;
+	Operation.Operation = EAssetStreamingOperation::Release;
+	Operation.RequestHandle = RequestHandle;
+
+	QueuedOperations.Enqueue(MoveTemp(Operation));
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	FAssetStreamingRequestHandle RequestHandle;
+	const bool bSuccess = RequestAssetStreaming(AssetsToStream, AssetLoadedCallback, RequestHandle, Priority);
+	OutAssetRequestId = RequestHandle.ToGuid();
+
+	return bSuccess;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	FAssetStreamingRequestHandle RequestHandle;
+	const bool bSuccess = RequestAssetStreaming(AssetToStream, AssetLoadedCallback, RequestHandle, Priority);
+	OutAssetRequestId = RequestHandle.ToGuid();
+
+	return bSuccess;
+}
+
+bool UAssetStreamingSubsystem::RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	FAssetStreamingRequestHandle RequestHandle;
+	const bool bSuccess = RequestAssetBatchStreaming(AssetsToStream, AssetLoadedCallback, RequestHandle, Priority);
+	OutAssetRequestId = RequestHandle.ToGuid();
+
+	return bSuccess;
+}
+
+bool UAssetStreamingSubsystem::ReleaseAssets(FGuid& RequestId)
+{
+	if (!RequestId.IsValid())
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to release assets using an invalid Guid."));
+		return false;
+	}
+
+	FAssetStreamingRequestHandle RequestHandle = FAssetStreamingRequestHandle::FromGuid(RequestId);
+	RequestId.Invalidate();
+
+	return ReleaseAssets(RequestHandle);
+}
+
+bool UAssetStreamingSubsystem::RaiseRequestPriority(const FGuid& RequestId, const EAssetStreamingPriority NewPriority)
+{
+	return RaiseRequestPriority(FAssetStreamingRequestHandle::FromGuid(RequestId), NewPriority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestMultipleAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetStreaming(AssetsToStream, nullptr, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestMultipleAssetStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetStreaming(AssetsToStream, AssetLoadedCallback, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetBatchStreaming(AssetsToStream, nullptr, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetBatchStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetBatchStreaming(AssetsToStream, AssetLoadedCallback, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetStreaming(AssetToStream, nullptr, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreamingWithCallback(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority)
+{
+	return RequestAssetStreaming(AssetToStream, AssetLoadedCallback, OutAssetRequestId, Priority);
+}
+
+bool UAssetStreamingSubsystem::K2_RequestAssetStreamingWithOptions(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const FAssetStreamingRequestOptions& Options, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority, const bool bAsBatch)
+{
+	FAssetStreamingRequestHandle RequestHandle;
+	const bool bSuccess = bAsBatch
+		? RequestAssetBatchStreaming(AssetsToStream, AssetLoadedCallback, RequestHandle, Priority, Options)
+		: RequestAssetStreaming(AssetsToStream, AssetLoadedCallback, RequestHandle, Priority, Options);
+	OutAssetRequestId = RequestHandle.ToGuid();
+
+	return bSuccess;
+}
+
+int32 UAssetStreamingSubsystem::K2_ReleaseAllForOwner(const UObject* Owner)
+{
+	return ReleaseAllForOwner(Owner);
+}
+
+int32 UAssetStreamingSubsystem::K2_ReleaseGroup(const FName Tag)
+{
+	return ReleaseGroup(Tag);
+}
+
+int64 UAssetStreamingSubsystem::K2_GetRequestResidentBytes(const FGuid& RequestId)
+{
+	return GetRequestResidentBytes(FAssetStreamingRequestHandle::FromGuid(RequestId));
+}
+
+TArray<FAssetStreamingOwnerMemory> UAssetStreamingSubsystem::K2_GetTopMemoryOwners(const int32 MaxOwners) const
+{
+	TArray<FAssetStreamingOwnerMemory> Owners;
+	GetTopMemoryOwners(MaxOwners, Owners);
+	return Owners;
+}
+
+TArray<FAssetStreamingStaleRequests> UAssetStreamingSubsystem::K2_FindStaleRequests(const float MinAgeSeconds) const
+{
+	TArray<FAssetStreamingStaleRequests> StaleRequests;
+	FindStaleRequests(MinAgeSeconds, StaleRequests);
+	return StaleRequests;
+}
+
+bool UAssetStreamingSubsystem::K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId)
+{
+	return ReleaseAssets(RequestId);
+}
+
+bool UAssetStreamingSubsystem::K2_RaiseRequestPriority(const FGuid& RequestId, const EAssetStreamingPriority NewPriority)
+{
+	return RaiseRequestPriority(RequestId, NewPriority);
+}
+
+void UAssetStreamingSubsystem::K2_WaitForRequests(UObject* WorldContextObject, const TArray<FGuid>& RequestIds, const float TimeoutSeconds, bool& bOutCompleted, FLatentActionInfo LatentInfo)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if (!World) return;
+
+	FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+	if (LatentActionManager.FindExistingAction<FAssetStreamingWaitAction>(LatentInfo.CallbackTarget, LatentInfo.UUID)) return;
+
+	TArray<FAssetStreamingRequestHandle> RequestHandles;
+	RequestHandles.Reserve(RequestIds.Num());
+	for (const FGuid& RequestId : RequestIds)
+	{
+		RequestHandles.Add(FAssetStreamingRequestHandle::FromGuid(RequestId));
+	}
+
+	LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID, new FAssetStreamingWaitAction(WaitForRequests(RequestHandles, TimeoutSeconds), bOutCompleted, LatentInfo));
+}
+
+float UAssetStreamingSubsystem::K2_GetRequestProgress(const FGuid& RequestId)
+{
+	return GetRequestProgress(FAssetStreamingRequestHandle::FromGuid(RequestId));
+}
+
+void UAssetStreamingSubsystem::StreamAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FAssetStreamingRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority)
+{
+	ASSET_STREAMING_SCOPE(StreamAsset);
+	checkf(!AssetToStream.IsNull(), TEXT("Attempted to stream null soft object pointer."));
+	const FSoftObjectPath& AssetPath = AssetToStream.ToSoftObjectPath();
+
+	// Each asset can only be referenced once by the same request.
+	if (Requests[RequestHandle.Index].Assets.Contains(FAssetHandlePair(AssetToStream, nullptr)))
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Attempted to register asset '%s' to request '%s' but it already exists there."), *AssetToStream.GetAssetName(), *RequestHandle.ToString());
+		return;
+	}
+
+	// Assets the net mode doesn't need are called back right away, without being loaded or tracked. The request stays valid and is released as usual.
+	if (ClassFilters.Num() > 0 && IsAssetClassExcluded(AssetPath))
+	{
+		NumExcludedAssets++;
+		if (AssetLoadedCallback.GetObject())
+		{
+			PendingCompletions.Add(FAssetStreamingCompletion(FAssetLoadWaiter(AssetToStream, AssetLoadedCallback, RequestHandle, FPlatformTime::Seconds(), true, true)));
+		}
+
+		UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Skipped asset '%s' of request '%s', its class is excluded."), *AssetToStream.GetAssetName(), *RequestHandle.ToString());
+		return;
+	}
+
+	if (bIsRecordingStartupManifest || PendingPreloadPaths.Num() > 0)
+	{
+		HandleStartupRequest(AssetPath);
+	}
+
+	if (bIsRecordingTrace)
+	{
+		Trace.RecordRequest(FPlatformTime::Seconds(), RequestHandle.Index, AssetPath);
+	}
+
+	const bool bIsAssetLoaded = AssetToStream.IsValid();
+	const double RequestTime = FPlatformTime::Seconds();
+	const int32 RecordIndex = FindOrAddRecord(AssetPath);
+	TSharedPtr<FStreamableHandle> Handle = Records[RecordIndex].KeepAlive;
+
+	// Requests at the default priority load the asset at the priority of its class policy.
+	const int32 PolicyIndex = Records[RecordIndex].PolicyIndex;
+	const EAssetStreamingPriority LoadPriority = Priority == EAssetStreamingPriority::Normal && PolicyIndex != INDEX_NONE ? ClassPolicies[PolicyIndex].DefaultPriority : Priority;
+
+	if (Handle.IsValid() && !Handle->WasCanceled() && (bIsAssetLoaded || Handle->IsLoadingInProgress()))
+	{
+		// We already keep the asset alive: share its handle instead of creating a new one.
+		// Resident assets are called back by the next pump, like the streamable manager does. Loading assets are called back with their pending load.
+		if (bIsAssetLoaded)
+		{
+			NumAlreadyLoadedHits++;
+			if (AssetLoadedCallback.GetObject())
+			{
+				PendingCompletions.Add(FAssetStreamingCompletion(FAssetLoadWaiter(AssetToStream, AssetLoadedCallback, RequestHandle, RequestTime, true)));
+			}
+		}
+		else
+		{
+			NumLoadMisses++;
+			Records[RecordIndex].Waiters.Add(FAssetLoadWaiter(AssetToStream, AssetLoadedCallback, RequestHandle, RequestTime, false));
+			NumLoadWaiters++;
+		}
+	}
+	else
+	{
+		// Request an asynchronous load of the asset, even if the asset is already loaded. It becomes the keep-alive handle of the asset.
+		// The load calls back every request waiting for the asset, not only this one.
+		Records[RecordIndex].Waiters.Add(FAssetLoadWaiter(AssetToStream, AssetLoadedCallback, RequestHandle, RequestTime, bIsAssetLoaded));
+		NumLoadWaiters++;
+
+		FStreamableDelegate OnLoaded;
+		OnLoaded.BindLambda([this, AssetPath = FSoftObjectPath(AssetPath), bIsAssetLoaded]()
+		{
+			if (!bIsAssetLoaded) NumInFlightLoads--;
+			NotifyLoadWaiters(AssetPath);
+		});
+		Handle = StreamableManager.RequestAsyncLoad(AssetPath, OnLoaded, GetAsyncLoadPriority(LoadPriority), true);
+
+		if (bIsAssetLoaded)
+		{
+			NumAlreadyLoadedHits++;
+		}
+		else
+		{
+			NumLoadMisses++;
+			NumInFlightLoads++;
+		}
+	}
+
+	// Increment the number of references for the asset, then register the asset and its handle to the request.
+	// The callbacks may already have run and requested more assets, so index the record and request slots again.
+	AddAssetReference(RecordIndex, Handle);
+	Requests[RequestHandle.Index].Assets.Add(FAssetHandlePair(AssetToStream, Handle, RecordIndex));
+
+	// Assets that were already loaded may never be notified by a load.
+	if (bIsAssetLoaded)
+	{
+		MeasureResidentBytes(RecordIndex);
+	}
+
+	if (Predictor.IsInitialized())
+	{
+		HandlePredictedRequest(AssetPath);
+	}
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Registered asset '%s' to request '%s'."), *AssetToStream.GetAssetName(), *RequestHandle.ToString());
+}
+
+void UAssetStreamingSubsystem::StreamOrQueueAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FAssetStreamingRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority)
+{
+	// Assets we already track don't need a new load, and must be referenced before their unload delay expires. Critical requests never wait.
+	if (!bSortLoadSubmissions || Priority == EAssetStreamingPriority::Critical || AssetToStream.IsNull() || AssetToStream.IsValid() || RecordIndices.Contains(AssetToStream.ToSoftObjectPath()))
+	{
+		StreamAsset(AssetToStream, RequestHandle, AssetLoadedCallback, Priority);
+		return;
+	}
+
+	// The window opens with the first queued load.
+	if (PendingLoads.Num() == 0)
+	{
+		PendingLoadsSubmitTime = FPlatformTime::Seconds() + LoadSubmissionWindowSeconds;
+	}
+
+	PendingLoads.Add(FAssetStreamingPendingLoad(AssetToStream, AssetLoadedCallback, RequestHandle));
+	UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Queued load of asset '%s' for request '%s'."), *AssetToStream.GetAssetName(), *RequestHandle.ToString());
+}
+
+void UAssetStreamingSubsystem::StreamDependencies(const TArrayView<const TSoftObjectPtr<UObject>> RequestedAssets, const FAssetStreamingRequestHandle& RequestHandle, const EAssetStreamingPriority Priority)
+{
+	ASSET_STREAMING_SCOPE(ExpandDependencies);
+
+	// Assets requested explicitly already hold a reference, and assets shared by several of them are only referenced once.
+	TSet<FSoftObjectPath> RegisteredPaths;
+	for (const TSoftObjectPtr<UObject>& Asset : RequestedAssets)
+	{
+		RegisteredPaths.Add(Asset.ToSoftObjectPath());
+	}
+
+	const int32 NumRegisteredPaths = RegisteredPaths.Num();
+	for (const TSoftObjectPtr<UObject>& Asset : RequestedAssets)
+	{
+		if (Asset.IsNull()) continue;
+
+		// The expansion is cached, but streaming a dependency may expand others, so copy it.
+		const TArray<FSoftObjectPath> AssetDependencies = Dependencies.Expand(Asset.ToSoftObjectPath(), MaxExpandedDependencies);
+		for (const FSoftObjectPath& DependencyPath : AssetDependencies)
+		{
+			bool bIsAlreadyRegistered;
+			RegisteredPaths.Add(DependencyPath, &bIsAlreadyRegistered);
+			if (bIsAlreadyRegistered) continue;
+
+			StreamOrQueueAsset(TSoftObjectPtr<UObject>(DependencyPath), RequestHandle, nullptr, Priority);
+		}
+	}
+
+	const int32 NumDependencies = RegisteredPaths.Num() - NumRegisteredPaths;
+	NumExpandedDependencies += NumDependencies;
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Registered %s dependencies to request '%s'."), *FString::FromInt(NumDependencies), *RequestHandle.ToString());
+}
+
+void UAssetStreamingSubsystem::SubmitPendingLoads()
+{
+	ASSET_STREAMING_SCOPE(StreamAsset);
+
+	// Callbacks may request more assets while we submit these, they're queued for the next window.
+	Swap(PendingLoads, PendingLoadsScratch);
+
+	for (FAssetStreamingPendingLoad& Load : PendingLoadsScratch)
+	{
+		// Requests may have been raised since their loads were queued.
+		const FAssetStreamingRequest* Request = FindRequest(Load.RequestHandle);
+		Load.Priority = Request ? Request->Priority : EAssetStreamingPriority::Background;
+		Load.OrderKey = LoadOrder.GetKey(Load.Asset.ToSoftObjectPath());
+	}
+
+	// The async loader serves higher priorities first anyway. Within a priority, packages are read in the order they are requested.
+	PendingLoadsScratch.StableSort([](const FAssetStreamingPendingLoad& A, const FAssetStreamingPendingLoad& B)
+	{
+		if (A.Priority != B.Priority) return A.Priority > B.Priority;
+		return A.OrderKey < B.OrderKey;
+	});
+
+	int32 NumSubmitted = 0;
+	for (const FAssetStreamingPendingLoad& Load : PendingLoadsScratch)
+	{
+		// Requests released before the window closed have nothing left to load, and callbacks may release others while we submit.
+		if (!FindRequest(Load.RequestHandle)) continue;
+
+		StreamAsset(Load.Asset, Load.RequestHandle, Load.Callback, Load.Priority);
+		NumSubmitted++;
+	}
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Submitted %s sorted load(s)."), *FString::FromInt(NumSubmitted));
+	PendingLoadsScratch.Reset();
+}
+
+bool UAssetStreamingSubsystem::StreamAssetBatch(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const FAssetStreamingRequestHandle& RequestHandle, const TSharedRef<FAssetStreamingBatch>& Batch, const EAssetStreamingPriority Priority)
+{
+	ASSET_STREAMING_SCOPE(StreamAsset);
+
+	Batch->Assets.Reserve(AssetsToStream.Num());
+	Batch->RequestTime = FPlatformTime::Seconds();
+	Batch->bIsInFlight = false;
+
+	// Gather the paths to stream, ignoring duplicates so that each asset is only referenced once by this request.
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Reserve(AssetsToStream.Num());
+	TSet<FSoftObjectPath> UniquePaths;
+	UniquePaths.Reserve(AssetsToStream.Num());
+
+	for (const TSoftObjectPtr<UObject>& Asset : AssetsToStream)
+	{
+		checkf(!Asset.IsNull(), TEXT("Attempted to stream null soft object pointer."));
+
+		bool bIsDuplicate = false;
+		UniquePaths.Add(Asset.ToSoftObjectPath(), &bIsDuplicate);
+		if (bIsDuplicate)
+		{
+			UE_LOG(LogAssetStreaming, Warning, TEXT("Asset '%s' is present multiple times in the same batch, ignoring duplicates."), *Asset.GetAssetName());
+			continue;
+		}
+
+		// Assets the net mode doesn't need keep their place in the batch, but aren't loaded.
+		const bool bIsExcluded = ClassFilters.Num() > 0 && IsAssetClassExcluded(Asset.ToSoftObjectPath());
+		Batch->Assets.Add(Asset);
+		Batch->Excluded.Add(bIsExcluded);
+		Batch->WasAlreadyLoaded.Add(Asset.IsValid() || bIsExcluded);
+
+		if (bIsExcluded)
+		{
+			NumExcludedAssets++;
+			continue;
+		}
+
+		if (bIsRecordingStartupManifest || PendingPreloadPaths.Num() > 0)
+		{
+			HandleStartupRequest(Asset.ToSoftObjectPath());
+		}
+
+		AssetPaths.Add(Asset.ToSoftObjectPath());
+		Batch->bIsInFlight |= !Asset.IsValid();
+	}
+	Batch->Notified.Init(false, Batch->Assets.Num());
+
+	// Excluded assets are called back right away.
+	const int32 NumExcluded = Batch->Assets.Num() - AssetPaths.Num();
+	for (int32 Index = 0; Index < Batch->Assets.Num() && NumExcluded > 0; Index++)
+	{
+		if (!Batch->Excluded[Index]) continue;
+
+		Batch->Notified[Index] = true;
+		if (Batch->Callback.GetObject() || Batch->OnAssetLoaded)
+		{
+			PendingCompletions.Add(FAssetStreamingCompletion(Batch, Index));
+		}
+	}
+
+	// Nothing left to load, the whole batch is called back by the next pump.
+	if (AssetPaths.Num() == 0)
+	{
+		PendingCompletions.Add(FAssetStreamingCompletion(Batch, INDEX_NONE));
+		return true;
+	}
+
+	// The batch is already a single submission, it only needs sorting.
+	if (bSortLoadSubmissions)
+	{
+		LoadOrder.Sort(AssetPaths);
+	}
+
+	// Request an asynchronous load of the whole batch using a single handle.
+	// The update delegate notifies assets as they are loaded, the completion delegate notifies the whole batch.
+	FStreamableDelegate OnLoaded;
+	OnLoaded.BindLambda([this, Batch]() { HandleBatchLoaded(Batch); });
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPaths, OnLoaded, GetAsyncLoadPriority(Priority), true);
+
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Streamable manager refused to stream batch for request '%s'."), *RequestHandle.ToString());
+		return false;
+	}
+
+	// The whole batch counts as a single in-flight load. Excluded assets are neither hits nor misses.
+	const int32 NumAlreadyLoaded = Batch->WasAlreadyLoaded.CountSetBits() - NumExcluded;
+	NumAlreadyLoadedHits += NumAlreadyLoaded;
+	NumLoadMisses += AssetPaths.Num() - NumAlreadyLoaded;
+	if (Batch->bIsInFlight) NumInFlightLoads++;
+
+	if (!Handle->HasLoadCompleted())
+	{
+		FStreamableUpdateDelegate OnUpdated;
+		OnUpdated.BindLambda([this, Batch](TSharedRef<FStreamableHandle> UpdatedHandle) { HandleBatchUpdated(Batch); });
+		Handle->BindUpdateDelegate(OnUpdated);
+	}
+
+	// Register all assets and the shared handle to the request at once.
+	FAssetHandleArray& RequestAssets = Requests[RequestHandle.Index].Assets;
+	RequestAssets.Reserve(AssetPaths.Num());
+
+	// The batch handle becomes the keep-alive handle of every asset that doesn't already have one.
+	for (int32 Index = 0; Index < Batch->Assets.Num(); Index++)
+	{
+		if (Batch->Excluded[Index]) continue;
+
+		const TSoftObjectPtr<UObject>& Asset = Batch->Assets[Index];
+		const int32 RecordIndex = FindOrAddRecord(Asset.ToSoftObjectPath());
+		AddAssetReference(RecordIndex, Handle);
+		RequestAssets.Add(FAssetHandlePair(Asset, Handle, RecordIndex));
+
+		if (bIsRecordingTrace)
+		{
+			Trace.RecordRequest(Batch->RequestTime, RequestHandle.Index, Asset.ToSoftObjectPath());
+		}
+	}
+
+	if (Predictor.IsInitialized())
+	{
+		for (const FSoftObjectPath& AssetPath : AssetPaths)
+		{
+			HandlePredictedRequest(AssetPath);
+		}
+	}
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Registered batch of %s asset(s) to request '%s'."), *FString::FromInt(Batch->Assets.Num()), *RequestHandle.ToString());
+
+	return true;
+}
+
+void UAssetStreamingSubsystem::RegisterStreamingComponent(UAssetStreamingComponent* Component)
+{
+	CheckThis();
+	check(IsInGameThread());
+	checkf(Component, TEXT("Attempted to register a null streaming component."));
+
+	if (Component->ProximityIndex != INDEX_NONE)
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Streaming component '%s' is already registered."), *Component->GetName());
+		return;
+	}
+
+	// Static components are bucketed once, movable ones are moved between cells when they're evaluated.
+	const FVector Location = Component->GetStreamingLocation();
+	const FIntPoint Cell = ProximityGrid.GetCell(Location);
+	const int32 EntryIndex = ProximityEntries.Add(FAssetStreamingProximityEntry(Component, Location, Cell));
+	ProximityGrid.Add(EntryIndex, Cell);
+
+	if (Component->bIsMovable) ActiveProximityEntries.Add(EntryIndex);
+	MaxProximityExitRadius = FMath::Max(MaxProximityExitRadius, FMath::Max(Component->EnterRadius, Component->ExitRadius));
+
+	Component->StreamingSubsystem = this;
+	Component->ProximityIndex = EntryIndex;
+}
+
+void UAssetStreamingSubsystem::UnregisterStreamingComponent(UAssetStreamingComponent* Component)
+{
+	CheckThis();
+	check(IsInGameThread());
+
+	if (!Component || !ProximityEntries.IsValidIndex(Component->ProximityIndex) || ProximityEntries[Component->ProximityIndex].Component != Component) return;
+
+	RemoveProximityEntry(Component->ProximityIndex);
+}
+
+void UAssetStreamingSubsystem::SetViewLocationsOverride(const TArray<FVector>& Locations)
+{
+	CheckThis();
+	ViewLocations = Locations;
+	bHasViewLocationsOverride = true;
+}
+
+void UAssetStreamingSubsystem::ClearViewLocationsOverride()
+{
+	CheckThis();
+	bHasViewLocationsOverride = false;
+}
+
+void UAssetStreamingSubsystem::EvaluateProximity()
+{
+	ASSET_STREAMING_SCOPE(EvaluateProximity);
+
+	if (NextProximityCandidate >= ProximityCandidates.Num())
+	{
+		StartProximityCycle();
+	}
+
+	const int32 LastCandidate = FMath::Min(ProximityCandidates.Num(), NextProximityCandidate + FMath::Max(ProximityEvaluationsPerTick, 1));
+	while (NextProximityCandidate < LastCandidate)
+	{
+		EvaluateProximityEntry(ProximityCandidates[NextProximityCandidate++]);
+	}
+}
+
+void UAssetStreamingSubsystem::StartProximityCycle()
+{
+	ProximityCandidates.Reset();
+	NextProximityCandidate = 0;
+
+	if (!bHasViewLocationsOverride)
+	{
+		ViewLocations.Reset();
+
+		const UGameInstance* GameInstance = GetGameInstance();
+		const UWorld* World = GameInstance ? GameInstance->GetWorld() : nullptr;
+		if (World)
+		{
+			for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+			{
+				const APlayerController* PlayerController = It->Get();
+				if (!PlayerController) continue;
+
+				FVector Location;
+				FRotator Rotation;
+				PlayerController->GetPlayerViewPoint(Location, Rotation);
+				ViewLocations.Add(Location);
+			}
+		}
+	}
+
+	// Without any view, i.e. while travelling, keep streaming what is already streamed.
+	if (ViewLocations.Num() == 0) return;
+
+	ProximityCycle++;
+
+	// Entries far from every view are never visited, only the ones in nearby cells and the active ones are.
+	ProximityQueryScratch.Reset();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ProximityGrid.Query(ViewLocation, MaxProximityExitRadius, ProximityQueryScratch);
+	}
+	for (const int32 EntryIndex : ActiveProximityEntries)
+	{
+		ProximityQueryScratch.Add(EntryIndex);
+	}
+
+	for (const int32 EntryIndex : ProximityQueryScratch)
+	{
+		FAssetStreamingProximityEntry& Entry = ProximityEntries[EntryIndex];
+		if (Entry.LastCycle == ProximityCycle) continue;
+
+		Entry.LastCycle = ProximityCycle;
+		ProximityCandidates.Add(EntryIndex);
+	}
+}
+
+void UAssetStreamingSubsystem::EvaluateProximityEntry(const int32 EntryIndex)
+{
+	// Entries removed since the cycle started are skipped. Reused ones are evaluated early, which is harmless.
+	if (!ProximityEntries.IsValidIndex(EntryIndex)) return;
+
+	FAssetStreamingProximityEntry& Entry = ProximityEntries[EntryIndex];
+	UAssetStreamingComponent* Component = Entry.Component.Get();
+	if (!Component)
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Streaming component was destroyed without ending play, releasing its assets."));
+		RemoveProximityEntry(EntryIndex);
+		return;
+	}
+
+	if (Component->bIsMovable)
+	{
+		Entry.Location = Component->GetStreamingLocation();
+		const FIntPoint Cell = ProximityGrid.GetCell(Entry.Location);
+		if (Cell != Entry.Cell)
+		{
+			ProximityGrid.Remove(EntryIndex, Entry.Cell);
+			ProximityGrid.Add(EntryIndex, Cell);
+			Entry.Cell = Cell;
+		}
+	}
+
+	float ClosestDistanceSquared = TNumericLimits<float>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared, FVector::DistSquared(ViewLocation, Entry.Location));
+	}
+
+	// The exit radius is never below the enter radius, otherwise assets would be released as soon as they're requested.
+	const float ExitRadius = FMath::Max(Component->EnterRadius, Component->ExitRadius);
+
+	// Requests released behind the component's back, in bulk or along with a destroyed owner, are requested again while in range.
+	if (Entry.RequestHandle.IsValid() && !FindRequest(Entry.RequestHandle))
+	{
+		Entry.RequestHandle.Invalidate();
+		if (!Component->bIsMovable) ActiveProximityEntries.Remove(EntryIndex);
+		Component->bIsStreamingAssets = false;
+	}
+
+	if (!Entry.RequestHandle.IsValid())
+	{
+		if (ClosestDistanceSquared > FMath::Square(Component->EnterRadius)) return;
+
+		FAssetStreamingRequestHandle RequestHandle;
+		const bool bIsRequested = Component->bStreamAsBatch
+			? RequestAssetBatchStreaming(Component->Assets, nullptr, RequestHandle, Component->Priority, FAssetStreamingRequestOptions(Component))
+			: RequestAssetStreaming(Component->Assets, nullptr, RequestHandle, Component->Priority, FAssetStreamingRequestOptions(Component));
+		if (!bIsRequested) return;
+
+		// Requests may have moved the entries around.
+		ProximityEntries[EntryIndex].RequestHandle = RequestHandle;
+		ActiveProximityEntries.Add(EntryIndex);
+		Component->bIsStreamingAssets = true;
+	}
+	else if (ClosestDistanceSquared > FMath::Square(ExitRadius))
+	{
+		ReleaseAssets(Entry.RequestHandle);
+		if (!Component->bIsMovable) ActiveProximityEntries.Remove(EntryIndex);
+		Component->bIsStreamingAssets = false;
+	}
+}
+
+void UAssetStreamingSubsystem::RemoveProximityEntry(const int32 EntryIndex)
+{
+	FAssetStreamingProximityEntry& Entry = ProximityEntries[EntryIndex];
+	if (FindRequest(Entry.RequestHandle))
+	{
+		ReleaseAssets(Entry.RequestHandle);
+	}
+
+	if (UAssetStreamingComponent* Component = Entry.Component.Get())
+	{
+		Component->StreamingSubsystem.Reset();
+		Component->ProximityIndex = INDEX_NONE;
+		Component->bIsStreamingAssets = false;
+	}
+
+	ProximityGrid.Remove(EntryIndex, Entry.Cell);
+	ActiveProximityEntries.Remove(EntryIndex);
+	ProximityEntries.RemoveAt(EntryIndex);
+}
+
+void UAssetStreamingSubsystem::StartStartupPreload()
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	if (!FAssetStreamingStartupManifest::Load(FAssetStreamingStartupManifest::GetDefaultFilename(), AssetPaths) || AssetPaths.Num() == 0) return;
+
+	// Background priority, so that the preload never delays what gameplay code actually requests.
+	StartupPreloadHandle = StreamableManager.RequestAsyncLoad(AssetPaths, FStreamableDelegate(), GetAsyncLoadPriority(EAssetStreamingPriority::Background), false);
+	if (!StartupPreloadHandle.IsValid()) return;
+
+	PendingPreloadPaths.Append(AssetPaths);
+	NumPreloadedAssets = PendingPreloadPaths.Num();
+	StartupPreloadEndTime = FPlatformTime::Seconds() + StartupPreloadTimeoutSeconds;
+
+	UE_LOG(LogAssetStreaming, Log, TEXT("Preloading %s assets from the startup manifest."), *FString::FromInt(NumPreloadedAssets));
+}
+
+void UAssetStreamingSubsystem::HandleStartupRequest(const FSoftObjectPath& AssetPath)
+{
+	if (bIsRecordingStartupManifest)
+	{
+		bool bIsAlreadyRecorded = false;
+		RecordedStartupPaths.Add(AssetPath, &bIsAlreadyRecorded);
+		if (!bIsAlreadyRecorded) StartupManifestPaths.Add(AssetPath);
+	}
+
+	// The request takes its own handle on the asset, loaded or loading already. The preload doesn't need to hold it anymore.
+	if (PendingPreloadPaths.Remove(AssetPath) > 0 && PendingPreloadPaths.Num() == 0)
+	{
+		ReleaseStartupPreload();
+	}
+}
+
+void UAssetStreamingSubsystem::FinishStartupRecording()
+{
+	bIsRecordingStartupManifest = false;
+
+	const FString Filename = FAssetStreamingStartupManifest::GetDefaultFilename();
+	if (FAssetStreamingStartupManifest::Save(Filename, StartupManifestPaths))
+	{
+		UE_LOG(LogAssetStreaming, Log, TEXT("Recorded %s assets to startup manifest '%s'."), *FString::FromInt(StartupManifestPaths.Num()), *Filename);
+	}
+	else
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Failed to write startup manifest '%s'."), *Filename);
+	}
+
+	StartupManifestPaths.Empty();
+	RecordedStartupPaths.Empty();
+}
+
+void UAssetStreamingSubsystem::ReleaseStartupPreload()
+{
+	if (!StartupPreloadHandle.IsValid()) return;
+
+	UE_LOG(LogAssetStreaming, Log, TEXT("Releasing startup preload, %s of %s assets were adopted by requests."),
+		*FString::FromInt(NumPreloadedAssets - PendingPreloadPaths.Num()), *FString::FromInt(NumPreloadedAssets));
+
+	// Assets that no request adopted are garbage collected like any unreferenced asset.
+	StartupPreloadHandle->ReleaseHandle();
+	StartupPreloadHandle.Reset();
+	PendingPreloadPaths.Empty();
+}
+
+void UAssetStreamingSubsystem::StartTraceRecording()
+{
+	CheckThis();
+
+	Trace.Reset(FPlatformTime::Seconds());
+	bIsRecordingTrace = true;
+}
+
+bool UAssetStreamingSubsystem::StopTraceRecording(const FString& Filename)
+{
+	CheckThis();
+
+	if (!bIsRecordingTrace) return false;
+	bIsRecordingTrace = false;
+
+	const FString TraceFilename = Filename.IsEmpty() ? FAssetStreamingTrace::GetDefaultFilename() : Filename;
+	const bool bIsSaved = Trace.Save(TraceFilename);
+	if (bIsSaved)
+	{
+		UE_LOG(LogAssetStreaming, Log, TEXT("Recorded %s events to asset streaming trace '%s'."), *FString::FromInt(Trace.Num()), *TraceFilename);
+	}
+	else
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Could not write asset streaming trace '%s'."), *TraceFilename);
+	}
+
+	// The trace can get large, don't keep it around once written.
+	Trace = FAssetStreamingTrace();
+	return bIsSaved;
+}
+
+void UAssetStreamingSubsystem::ProcessQueuedOperations()
+{
+	// Operations are processed in the order they were queued, so a release always finds the request queued before it.
+	FAssetStreamingQueuedOperation Operation;
+	int32 ProcessedCount = 0;
+
+	while (QueuedOperations.Dequeue(Operation))
+	{
+		ProcessedCount++;
+
+		if (Operation.Operation == EAssetStreamingOperation::Release)
+		{
+			// Queued handles resolve through the same path as releases made on the game thread, without processing the queue again.
+			if (Operation.RequestHandle.IsQueued() && !QueuedRequestHandles.Contains(Operation.RequestHandle))
+			{
+				UE_LOG(LogAssetStreaming, Verbose, TEXT("Queued request '%s' was already released."), *Operation.RequestHandle.ToString());
+				continue;
+			}
+
+			ReleaseAssets(Operation.RequestHandle);
+			continue;
+		}
+
+		FAssetStreamingRequestHandle SlotHandle;
+		const bool bRequested = Operation.Operation == EAssetStreamingOperation::BatchRequest
+			? RequestAssetBatchStreaming(Operation.Assets, Operation.Callback, SlotHandle, Operation.Priority, Operation.Options)
+			: RequestAssetStreaming(Operation.Assets, Operation.Callback, SlotHandle, Operation.Priority, Operation.Options);
+
+		if (bRequested)
+		{
+			QueuedRequestHandles.Add(Operation.RequestHandle, SlotHandle);
+			Requests[SlotHandle.Index].QueuedHandle = Operation.RequestHandle;
+		}
+	}
+
+	if (ProcessedCount > 0)
+	{
+		UE_LOG(LogAssetStreaming, Verbose, TEXT("Processed %s operation(s) queued by other threads."), *FString::FromInt(ProcessedCount));
+	}
+}
+
+FAssetStreamingRequestHandle UAssetStreamingSubsystem::ResolveRequestHandle(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	if (!RequestHandle.IsQueued()) return RequestHandle;
+
+	// The request may still be waiting in the queue, submit it right away.
+	const FAssetStreamingRequestHandle* SlotHandle = QueuedRequestHandles.Find(RequestHandle);
+	if (!SlotHandle && !QueuedOperations.IsEmpty())
+	{
+		ProcessQueuedOperations();
+		SlotHandle = QueuedRequestHandles.Find(RequestHandle);
+	}
+
+	return SlotHandle ? *SlotHandle : FAssetStreamingRequestHandle();
+}
+
+FAssetStreamingRequestHandle UAssetStreamingSubsystem::AllocateRequest(const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options)
+{
+	checkf(IsInGameThread(), TEXT("Assets can only be requested on the game thread. Use EnqueueAssetStreaming() from other threads."));
+
+	// Reuse a free slot if we have one, its asset array keeps its memory.
+	const uint32 Index = FreeRequestSlots.Num() > 0 ? FreeRequestSlots.Pop(false) : static_cast<uint32>(Requests.AddDefaulted());
+
+	FAssetStreamingRequest& Request = Requests[Index];
+	checkf(!Request.bIsActive, TEXT("Attempted to allocate request slot %u but it is already in use."), Index);
+
+	Request.Priority = Priority;
+	Request.Owner = Options.Owner;
+	Request.Tag = Options.Tag;
+	Request.Callsite = Options.Callsite;
+	Request.RequestTime = FPlatformTime::Seconds();
+	Request.bIsActive = true;
+
+	return FAssetStreamingRequestHandle(Index, Request.Generation);
+}
+
+FAssetStreamingRequest* UAssetStreamingSubsystem::FindRequest(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	if (!RequestHandle.IsValid() || RequestHandle.Index >= static_cast<uint32>(Requests.Num())) return nullptr;
+
+	FAssetStreamingRequest& Request = Requests[RequestHandle.Index];
+	return Request.bIsActive && Request.Generation == RequestHandle.Generation ? &Request : nullptr;
+}
+
+void UAssetStreamingSubsystem::FreeRequest(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	// Every release goes through here, including the bulk ones.
+	if (bIsRecordingTrace)
+	{
+		Trace.RecordRelease(FPlatformTime::Seconds(), RequestHandle.Index);
+	}
+
+	FAssetStreamingRequest& Request = Requests[RequestHandle.Index];
+	Request.Assets.Reset();
+	Request.Owner.Reset();
+	Request.Tag = NAME_None;
+	Request.bIsActive = false;
+
+	// Queued handles of requests released in bulk would otherwise stay mapped forever.
+	if (Request.QueuedHandle.IsValid())
+	{
+		QueuedRequestHandles.Remove(Request.QueuedHandle);
+		Request.QueuedHandle.Invalidate();
+	}
+
+	// Bump the generation so that stale handles don't resolve to the next request using this slot.
+	// Zero is reserved for invalid handles, and the highest bit for queued handles.
+	Request.Generation = Request.Generation == FAssetStreamingRequestHandle::QueuedGenerationBit - 1 ? 1 : Request.Generation + 1;
+
+	FreeRequestSlots.Add(RequestHandle.Index);
+}
+
+TAsyncLoadPriority UAssetStreamingSubsystem::GetAsyncLoadPriority(const EAssetStreamingPriority Priority)
+{
+	switch (Priority)
+	{
+	case EAssetStreamingPriority::Background:
+		return FStreamableManager::DefaultAsyncLoadPriority - 50;
+	case EAssetStreamingPriority::Visible:
+		return FStreamableManager::DefaultAsyncLoadPriority + 50;
+	case EAssetStreamingPriority::Critical:
+		return FStreamableManager::AsyncLoadHighPriority;
+	default:
+		return FStreamableManager::DefaultAsyncLoadPriority;
+	}
+}
+
+int32 UAssetStreamingSubsystem::FindOrAddRecord(const FSoftObjectPath& AssetPath)
+{
+	checkf(!AssetPath.IsNull(), TEXT("Cannot track null asset."));
+
+	// Hash the path only once, whether the record exists or not.
+	const uint32 PathHash = GetTypeHash(AssetPath);
+	if (const int32* FoundIndex = RecordIndices.FindByHash(PathHash, AssetPath))
+	{
+		return *FoundIndex;
+	}
+
+	const int32 RecordIndex = Records.Add(FAssetStreamingRecord(AssetPath));
+	RecordIndices.AddByHash(PathHash, AssetPath, RecordIndex);
+
+	if (ClassPolicies.Num() > 0)
+	{
+		Records[RecordIndex].PolicyIndex = FindClassPolicy(AssetPath);
+	}
+
+	return RecordIndex;
+}
+
+void UAssetStreamingSubsystem::AddAssetReference(const int32 RecordIndex, const TSharedPtr<FStreamableHandle>& Handle)
+{
+	FAssetStreamingRecord& Record = Records[RecordIndex];
+
+	// We need to keep one handle alive at all times so that we choose when to unload the asset.
+	// To do this, we keep the first handle for each asset and never unload it until we really want to release the asset.
+	if (!Record.KeepAlive.IsValid() && Handle.IsValid())
+	{
+		Record.KeepAlive = Handle;
+		NumKeepAliveHandles++;
+	}
+
+	// Take the asset back from the warm cache or the unload queue if it was released earlier.
+	if (Record.State == EAssetRecordState::Cached)
+	{
+		GetWarmCache(Record.PolicyIndex).Remove(Record.CacheSlot);
+		Record.CacheSlot = INDEX_NONE;
+	}
+	else if (Record.State == EAssetRecordState::PendingUnload)
+	{
+		NumPendingUnloads--;
+	}
+	Record.UnloadSerial = 0;
+	Record.State = EAssetRecordState::Referenced;
+
+	Record.RequestCount++;
+}
+
+void UAssetStreamingSubsystem::MeasureResidentBytes(const int32 RecordIndex)
+{
+	if (Records[RecordIndex].ResidentBytes > 0) return;
+
+	if (UObject* Object = Records[RecordIndex].AssetPath.ResolveObject())
+	{
+		SetResidentBytes(RecordIndex, Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+
+		if (bIsRecordingTrace)
+		{
+			Trace.RecordLoaded(FPlatformTime::Seconds(), Records[RecordIndex].AssetPath, Records[RecordIndex].ResidentBytes);
+		}
+	}
+}
+
+void UAssetStreamingSubsystem::SetResidentBytes(const int32 RecordIndex, const int64 ResidentBytes)
+{
+	FAssetStreamingRecord& Record = Records[RecordIndex];
+	TrackedResidentBytes += ResidentBytes - Record.ResidentBytes;
+	Record.ResidentBytes = ResidentBytes;
+}
+
+void UAssetStreamingSubsystem::UpdateMemoryWatermarks()
+{
+	// Watermarks are sorted, so they're crossed in order going up and rearmed in reverse order going down.
+	while (NumWatermarksCrossed < MemoryWatermarksBytes.Num() && TrackedResidentBytes >= MemoryWatermarksBytes[NumWatermarksCrossed])
+	{
+		const int64 Watermark = MemoryWatermarksBytes[NumWatermarksCrossed++];
+
+		// Point at the most likely culprit right away, the full report is one console command away.
+		TArray<FAssetStreamingOwnerMemory> Owners;
+		GetTopMemoryOwners(1, Owners);
+		const FAssetStreamingOwnerMemory LargestOwner = Owners.Num() > 0 ? Owners[0] : FAssetStreamingOwnerMemory();
+
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Tracked assets rose above the %lld bytes watermark, %lld bytes are resident. Largest owner: '%s' with %lld bytes."),
+			Watermark, TrackedResidentBytes, *LargestOwner.Owner.ToString(), LargestOwner.ResidentBytes);
+
+		OnMemoryWatermarkCrossed.Broadcast(Watermark, TrackedResidentBytes);
+	}
+
+	while (NumWatermarksCrossed > 0 && TrackedResidentBytes < MemoryWatermarksBytes[NumWatermarksCrossed - 1])
+	{
+		NumWatermarksCrossed--;
+	}
+}
+
+TFuture<bool> UAssetStreamingSubsystem::WaitForRequests(const TArray<FAssetStreamingRequestHandle>& RequestHandles, const float TimeoutSeconds)
+{
+	CheckThis();
+	checkf(IsInGameThread(), TEXT("Requests can only be waited on from the game thread."));
+
+	FAssetStreamingBarrier Barrier(RequestHandles, TimeoutSeconds > 0.0f ? FPlatformTime::Seconds() + TimeoutSeconds : MAX_dbl);
+	for (FAssetStreamingRequestHandle& RequestHandle : Barrier.RequestHandles)
+	{
+		RequestHandle = ResolveRequestHandle(RequestHandle);
+	}
+
+	BoostRequests(Barrier.RequestHandles);
+	TFuture<bool> Future = Barrier.Promise->GetFuture();
+
+	// Requests that are already loaded don't need to wait for the next tick.
+	if (Barrier.RequestHandles.ContainsByPredicate([this](const FAssetStreamingRequestHandle& RequestHandle) { return !IsRequestComplete(RequestHandle); }))
+	{
+		Barriers.Add(MoveTemp(Barrier));
+	}
+	else
+	{
+		Barrier.Promise->SetValue(true);
+	}
+
+	return Future;
+}
+
+bool UAssetStreamingSubsystem::WaitForRequestsBlocking(const TArray<FAssetStreamingRequestHandle>& RequestHandles, const float TimeoutSeconds)
+{
+	CheckThis();
+	checkf(IsInGameThread(), TEXT("Requests can only be waited on from the game thread."));
+	ASSET_STREAMING_SCOPE(WaitForRequests);
+
+	TArray<FAssetStreamingRequestHandle> ResolvedHandles;
+	ResolvedHandles.Reserve(RequestHandles.Num());
+	for (const FAssetStreamingRequestHandle& RequestHandle : RequestHandles)
+	{
+		ResolvedHandles.Add(ResolveRequestHandle(RequestHandle));
+	}
+
+	BoostRequests(ResolvedHandles);
+
+	// Gather the loading handles first: the loaded callbacks run during the wait, and may release requests.
+	TArray<TSharedPtr<FStreamableHandle>> LoadingHandles;
+	for (const FAssetStreamingRequestHandle& RequestHandle : ResolvedHandles)
+	{
+		if (const FAssetStreamingRequest* Request = FindRequest(RequestHandle))
+		{
+			for (const FAssetHandlePair& Pair : Request->Assets)
+			{
+				if (Pair.Handle.IsValid() && Pair.Handle->IsLoadingInProgress()) LoadingHandles.AddUnique(Pair.Handle);
+			}
+		}
+	}
+
+	// Waiting without a timeout is how the streamable manager waits forever, so only pass it positive timeouts.
+	const double Deadline = TimeoutSeconds > 0.0f ? FPlatformTime::Seconds() + TimeoutSeconds : MAX_dbl;
+	for (const TSharedPtr<FStreamableHandle>& Handle : LoadingHandles)
+	{
+		const double RemainingSeconds = Deadline - FPlatformTime::Seconds();
+		if (RemainingSeconds <= 0.0) break;
+
+		Handle->WaitUntilComplete(Deadline == MAX_dbl ? 0.0f : FMath::Max(static_cast<float>(RemainingSeconds), SMALL_NUMBER));
+	}
+
+	return !ResolvedHandles.ContainsByPredicate([this](const FAssetStreamingRequestHandle& RequestHandle) { return !IsRequestComplete(RequestHandle); });
+}
+
+float UAssetStreamingSubsystem::GetRequestProgress(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	CheckThis();
+
+	const FAssetStreamingRequestHandle ResolvedHandle = ResolveRequestHandle(RequestHandle);
+	const FAssetStreamingRequest* Request = FindRequest(ResolvedHandle);
+	if (!Request) return 0.0f;
+
+	// Loads queued for sorting haven't started yet.
+	int32 NumAssets = Request->Assets.Num();
+	for (const FAssetStreamingPendingLoad& Load : PendingLoads)
+	{
+		if (Load.RequestHandle == ResolvedHandle) NumAssets++;
+	}
+
+	if (NumAssets == 0) return 1.0f;
+
+	float LoadedAssets = 0.0f;
+	for (const FAssetHandlePair& Pair : Request->Assets)
+	{
+		// Batch handles report the progress of the whole batch.
+		const bool bIsLoading = !Pair.Asset.IsValid() && Pair.Handle.IsValid() && Pair.Handle->IsLoadingInProgress();
+		LoadedAssets += bIsLoading ? Pair.Handle->GetLoadProgress() : 1.0f;
+	}
+
+	return LoadedAssets / NumAssets;
+}
+
+bool UAssetStreamingSubsystem::IsRequestComplete(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	const FAssetStreamingRequest* Request = FindRequest(RequestHandle);
+	if (!Request) return false;
+
+	for (const FAssetHandlePair& Pair : Request->Assets)
+	{
+		if (!Pair.Asset.IsValid() && Pair.Handle.IsValid() && Pair.Handle->IsLoadingInProgress()) return false;
+	}
+
+	return !PendingLoads.ContainsByPredicate([&RequestHandle](const FAssetStreamingPendingLoad& Load) { return Load.RequestHandle == RequestHandle; });
+}
+
+void UAssetStreamingSubsystem::BoostRequests(const TArray<FAssetStreamingRequestHandle>& RequestHandles)
+{
+	for (const FAssetStreamingRequestHandle& RequestHandle : RequestHandles)
+	{
+		const FAssetStreamingRequest* Request = FindRequest(RequestHandle);
+		if (Request && Request->Priority != EAssetStreamingPriority::Critical)
+		{
+			RaiseRequestPriority(RequestHandle, EAssetStreamingPriority::Critical);
+		}
+	}
+
+	// Loads queued for sorting would wait for the window to close. They're submitted at their raised priority, ahead of the others.
+	if (PendingLoads.Num() > 0)
+	{
+		SubmitPendingLoads();
+	}
+}
+
+void UAssetStreamingSubsystem::UpdateBarriers()
+{
+	const double Now = FPlatformTime::Seconds();
+
+	// Resolving a promise may run continuations that wait on more requests, so resolve the barriers once they're out of the array.
+	TArray<TPair<FAssetStreamingBarrier, bool>> ResolvedBarriers;
+	for (int32 Index = Barriers.Num() - 1; Index >= 0; Index--)
+	{
+		const FAssetStreamingBarrier& Barrier = Barriers[Index];
+
+		bool bIsComplete = true;
+		bool bWasReleased = false;
+		for (const FAssetStreamingRequestHandle& RequestHandle : Barrier.RequestHandles)
+		{
+			if (!FindRequest(RequestHandle))
+			{
+				bWasReleased = true;
+				break;
+			}
+
+			bIsComplete = bIsComplete && IsRequestComplete(RequestHandle);
+		}
+
+		if (bIsComplete || bWasReleased || Now >= Barrier.Deadline)
+		{
+			ResolvedBarriers.Emplace(Barrier, bIsComplete && !bWasReleased);
+			Barriers.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	for (const TPair<FAssetStreamingBarrier, bool>& Resolved : ResolvedBarriers)
+	{
+		Resolved.Key.Promise->SetValue(Resolved.Value);
+	}
+}
+
+int64 UAssetStreamingSubsystem::GetRequestResidentBytes(const FAssetStreamingRequestHandle& RequestHandle)
+{
+	CheckThis();
+
+	const FAssetStreamingRequest* Request = FindRequest(ResolveRequestHandle(RequestHandle));
+	if (!Request) return 0;
+
+	int64 ResidentBytes = 0;
+	for (const FAssetHandlePair& Pair : Request->Assets)
+	{
+		ResidentBytes += Records[Pair.RecordIndex].ResidentBytes;
+	}
+
+	return ResidentBytes;
+}
+
+void UAssetStreamingSubsystem::GetTopMemoryOwners(const int32 MaxOwners, TArray<FAssetStreamingOwnerMemory>& OutOwners) const
+{
+	CheckThis();
+
+	OutOwners.Reset();
+
+	// Owners by name, and the assets already counted for each of them. Requests of the same owner often share assets.
+	TMap<FName, int32> OwnerIndices;
+	TSet<uint64> CountedAssets;
+
+	for (const FAssetStreamingRequest& Request : Requests)
+	{
+		if (!Request.bIsActive) continue;
+
+		const FName OwnerName = GetMemoryOwnerName(Request);
+		int32 OwnerIndex;
+		if (const int32* FoundIndex = OwnerIndices.Find(OwnerName))
+		{
+			OwnerIndex = *FoundIndex;
+		}
+		else
+		{
+			OwnerIndex = OutOwners.AddDefaulted();
+			OutOwners[OwnerIndex].Owner = OwnerName;
+			OwnerIndices.Add(OwnerName, OwnerIndex);
+		}
+
+		FAssetStreamingOwnerMemory& Owner = OutOwners[OwnerIndex];
+		Owner.NumRequests++;
+
+		for (const FAssetHandlePair& Pair : Request.Assets)
+		{
+			bool bIsAlreadyCounted;
+			CountedAssets.Add((static_cast<uint64>(OwnerIndex) << 32) | static_cast<uint32>(Pair.RecordIndex), &bIsAlreadyCounted);
+			if (bIsAlreadyCounted) continue;
+
+			Owner.ResidentBytes += Records[Pair.RecordIndex].ResidentBytes;
+			Owner.NumAssets++;
+		}
+	}
+
+	OutOwners.Sort([](const FAssetStreamingOwnerMemory& A, const FAssetStreamingOwnerMemory& B) { return A.ResidentBytes > B.ResidentBytes; });
+
+	if (MaxOwners > 0 && OutOwners.Num() > MaxOwners)
+	{
+		OutOwners.SetNum(MaxOwners);
+	}
+}
+
+FName UAssetStreamingSubsystem::GetMemoryOwnerName(const FAssetStreamingRequest& Request)
+{
+	static const FName UntaggedName(TEXT("Untagged"));
+	static const FName DestroyedOwnerName(TEXT("DestroyedOwner"));
+
+	if (!Request.Tag.IsNone()) return Request.Tag;
+	if (const UObject* Owner = Request.Owner.Get()) return Owner->GetClass()->GetFName();
+
+	// Owners that are gone don't release their requests on their own.
+	return Request.Owner.IsExplicitlyNull() ? UntaggedName : DestroyedOwnerName;
+}
+
+int32 UAssetStreamingSubsystem::FindStaleRequests(const float MinAgeSeconds, TArray<FAssetStreamingStaleRequests>& OutStaleRequests) const
+{
+	CheckThis();
+
+	OutStaleRequests.Reset();
+
+	const double Now = FPlatformTime::Seconds();
+	int32 NumStale = 0;
+
+	// Groups by owner and callsite, and the assets already counted for each of them.
+	TMap<TPair<FName, FName>, int32> GroupIndices;
+	TSet<uint64> CountedAssets;
+
+	// For each asset referenced by stale requests: the group referencing it, INDEX_NONE if several do, and the number of stale references.
+	TMap<int32, TPair<int32, int32>> StaleReferences;
+
+	for (const FAssetStreamingRequest& Request : Requests)
+	{
+		if (!Request.bIsActive) continue;
+
+		const bool bOwnerDestroyed = !Request.Owner.IsExplicitlyNull() && !Request.Owner.IsValid();
+		const double AgeSeconds = Now - Request.RequestTime;
+		if (!bOwnerDestroyed && AgeSeconds < MinAgeSeconds) continue;
+
+		NumStale++;
+
+		const TPair<FName, FName> GroupKey(GetMemoryOwnerName(Request), Request.Callsite);
+		int32 GroupIndex;
+		if (const int32* FoundIndex = GroupIndices.Find(GroupKey))
+		{
+			GroupIndex = *FoundIndex;
+		}
+		else
+		{
+			GroupIndex = OutStaleRequests.AddDefaulted();
+			OutStaleRequests[GroupIndex].Owner = GroupKey.Key;
+			OutStaleRequests[GroupIndex].Callsite = GroupKey.Value;
+			GroupIndices.Add(GroupKey, GroupIndex);
+		}
+
+		FAssetStreamingStaleRequests& Group = OutStaleRequests[GroupIndex];
+		Group.NumRequests++;
+		Group.OldestAgeSeconds = FMath::Max(Group.OldestAgeSeconds, static_cast<float>(AgeSeconds));
+		Group.bOwnerDestroyed |= bOwnerDestroyed;
+
+		for (const FAssetHandlePair& Pair : Request.Assets)
+		{
+			TPair<int32, int32>* References = StaleReferences.Find(Pair.RecordIndex);
+			if (!References)
+			{
+				References = &StaleReferences.Add(Pair.RecordIndex, TPair<int32, int32>(GroupIndex, 0));
+			}
+			else if (References->Key != GroupIndex)
+			{
+				References->Key = INDEX_NONE;
+			}
+			References->Value++;
+
+			bool bIsAlreadyCounted;
+			CountedAssets.Add((static_cast<uint64>(GroupIndex) << 32) | static_cast<uint32>(Pair.RecordIndex), &bIsAlreadyCounted);
+			if (!bIsAlreadyCounted) Group.ResidentBytes += Records[Pair.RecordIndex].ResidentBytes;
+		}
+	}
+
+	// Assets only the stale requests of a single group reference would be unloaded by releasing them.
+	for (const TPair<int32, TPair<int32, int32>>& References : StaleReferences)
+	{
+		const FAssetStreamingRecord& Record = Records[References.Key];
+		if (References.Value.Key != INDEX_NONE && References.Value.Value == Record.RequestCount)
+		{
+			OutStaleRequests[References.Value.Key].PinnedBytes += Record.ResidentBytes;
+		}
+	}
+
+	OutStaleRequests.Sort([](const FAssetStreamingStaleRequests& A, const FAssetStreamingStaleRequests& B)
+	{
+		return A.PinnedBytes != B.PinnedBytes ? A.PinnedBytes > B.PinnedBytes : A.ResidentBytes > B.ResidentBytes;
+	});
+
+	return NumStale;
+}
+
+void UAssetStreamingSubsystem::AuditStaleRequests()
 {
-	Super::Initialize(Collection);
+	TArray<FAssetStreamingStaleRequests> StaleRequests;
+	NumStaleRequests = FindStaleRequests(StaleRequestAgeSeconds, StaleRequests);
 
-	// Set the singleton instance to this instance.
-	Instance = this;
+	StalePinnedBytes = 0;
+	for (const FAssetStreamingStaleRequests& Group : StaleRequests)
+	{
+		StalePinnedBytes += Group.PinnedBytes;
+	}
 
-	// Sanity check on the asset unload delay.
-	if (UnloadDelaySeconds < 0.0f)
+	if (NumStaleRequests == 0) return;
+
+	UE_LOG(LogAssetStreaming, Warning, TEXT("Found %s stale request(s) pinning %s KB. Were they released?"), *FString::FromInt(NumStaleRequests), *FString::FromInt(StalePinnedBytes / 1024));
+
+	// The groups pinning the most memory are the ones worth fixing first.
+	static constexpr int32 MaxLoggedGroups = 10;
+	for (int32 Index = 0; Index < FMath::Min(StaleRequests.Num(), MaxLoggedGroups); Index++)
 	{
-		UE_LOG(LogAssetStreaming, Error, TEXT("UnloadDelaySeconds cannot be a negative number. Setting it to 5 seconds."));
-		UnloadDelaySeconds = 5.0f;
+		const FAssetStreamingStaleRequests& Group = StaleRequests[Index];
+		UE_LOG(LogAssetStreaming, Warning, TEXT("  %s at %s: %s request(s), oldest %s s, %s KB pinned%s."), *Group.Owner.ToString(), *Group.Callsite.ToString(), *FString::FromInt(Group.NumRequests),
+			*FString::FromInt(FMath::FloorToInt(Group.OldestAgeSeconds)), *FString::FromInt(Group.PinnedBytes / 1024), Group.bOwnerDestroyed ? TEXT(", owner destroyed") : TEXT(""));
 	}
 }
 
-void UAssetStreamingSubsystem::Deinitialize()
+void UAssetStreamingSubsystem::NotifyLoadWaiters(const FSoftObjectPath& AssetPath)
 {
-	Instance = nullptr;
+	const int32* RecordIndex = RecordIndices.Find(AssetPath);
+	if (!RecordIndex || Records[*RecordIndex].Waiters.Num() == 0) return;
+
+	// A handle that failed to load the asset doesn't mean the keep-alive handle is done with it.
+	const TSharedPtr<FStreamableHandle>& KeepAlive = Records[*RecordIndex].KeepAlive;
+	if (!AssetPath.ResolveObject() && KeepAlive.IsValid() && KeepAlive->IsLoadingInProgress()) return;
+
+	MeasureResidentBytes(*RecordIndex);
+
+	// Measure the latency right away, the callbacks are dispatched by the pump.
+	TArray<FAssetLoadWaiter> Waiters = MoveTemp(Records[*RecordIndex].Waiters);
+	NumLoadWaiters -= Waiters.Num();
+
+	for (const FAssetLoadWaiter& Waiter : Waiters)
+	{
+		if (!FindRequest(Waiter.RequestHandle)) continue;
+
+		RecordLoadLatency(Waiter.Asset, Waiter.bWasAlreadyLoaded, Waiter.RequestTime);
+		if (Waiter.Callback.GetObject())
+		{
+			PendingCompletions.Add(FAssetStreamingCompletion(Waiter));
+		}
+	}
 }
 
-bool UAssetStreamingSubsystem::RequestAssetStreaming(const TArray<TSoftObjectPtr<>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId)
+void UAssetStreamingSubsystem::RecordLoadLatency(const TSoftObjectPtr<UObject>& LoadedAsset, const bool bAlreadyLoaded, const double RequestTime)
 {
-	CheckThis();
+	// Assets that were already loaded don't say anything about the loader, only measure the others.
+	if (!bAlreadyLoaded && LoadedAsset.IsValid())
+	{
+		LatencyHistogram.Add(FPlatformTime::Seconds() - RequestTime);
+	}
+}
 
-	// Invalidate the request id if there is nothing to stream.
-	if (AssetsToStream.Num() == 0)
+// Drops the items a pump queue has already processed. Leftovers are only moved to the front once they make up less than half of the queue.
+template<typename ItemType>
+static void CompactPumpQueue(TArray<ItemType>& Queue, int32& NextIndex)
+{
+	if (NextIndex == Queue.Num())
 	{
-		OutAssetRequestId.Invalidate();
-		return false;
+		Queue.Reset();
+		NextIndex = 0;
+	}
+	else if (NextIndex > Queue.Num() / 2)
+	{
+		Queue.RemoveAt(0, NextIndex, false);
+		NextIndex = 0;
 	}
+}
 
-	// Assign a new guid to the request.
-	OutAssetRequestId = FGuid::NewGuid();
+void UAssetStreamingSubsystem::Pump()
+{
+	ASSET_STREAMING_SCOPE(Pump);
+
+	const double Deadline = PumpBudgetMs > 0.0f ? FPlatformTime::Seconds() + PumpBudgetMs / 1000.0 : TNumericLimits<double>::Max();
+
+	// Callbacks may request resident assets, their own callbacks wait for the next frame.
+	const int32 NumCompletions = PendingCompletions.Num();
+	bool bHasProgressed = false;
+
+	while (NextCompletionIndex < NumCompletions && (!bHasProgressed || FPlatformTime::Seconds() < Deadline))
+	{
+		// Callbacks may also grow the queue, take the completion out first.
+		const FAssetStreamingCompletion Completion = MoveTemp(PendingCompletions[NextCompletionIndex++]);
+		DispatchCompletion(Completion);
+		bHasProgressed = true;
+	}
+	const int32 NumCompletionsLeft = NumCompletions - NextCompletionIndex;
+	CompactPumpQueue(PendingCompletions, NextCompletionIndex);
 
-	UE_LOG(LogAssetStreaming, Verbose, TEXT("Request to stream %s asset(s) received. Request Id: %s"), *FString::FromInt(AssetsToStream.Num()), *OutAssetRequestId.ToString());
-	for (TSoftObjectPtr<UObject> Asset : AssetsToStream)
+	bHasProgressed = false;
+	if (NextExpiredUnloadIndex < ExpiredUnloads.Num())
 	{
-		StreamAsset(Asset, OutAssetRequestId, AssetLoadedCallback);
+		// Expired unloads and warm cache evictions alike.
+		ASSET_STREAMING_SCOPE(FinalUnloadAssets);
+
+		while (NextExpiredUnloadIndex < ExpiredUnloads.Num() && (!bHasProgressed || FPlatformTime::Seconds() < Deadline))
+		{
+			// Only unload records that are still waiting for this entry. Requesting an asset again clears its serial.
+			const FAssetUnloadQueue::FEntry Entry = ExpiredUnloads[NextExpiredUnloadIndex++];
+			if (Records.IsValidIndex(Entry.RecordIndex) && Records[Entry.RecordIndex].UnloadSerial == Entry.Serial)
+			{
+				FinalUnloadAsset(Entry.RecordIndex);
+				bHasProgressed = true;
+			}
+		}
 	}
+	const int32 NumUnloadsLeft = ExpiredUnloads.Num() - NextExpiredUnloadIndex;
+	CompactPumpQueue(ExpiredUnloads, NextExpiredUnloadIndex);
+
+	const bool bIsBehind = NumCompletionsLeft > 0 || NumUnloadsLeft > 0;
+	NumPumpFramesBehind = bIsBehind ? NumPumpFramesBehind + 1 : 0;
 
-	// Any asset streaming operation that passes assertions but still isn't valid will cause the request id to invalidate.
-	return OutAssetRequestId.IsValid();
+	UE_CLOG(bIsBehind, LogAssetStreaming, VeryVerbose, TEXT("Pump ran out of budget, carrying %s callbacks and %s unloads over to the next frame."), *FString::FromInt(NumCompletionsLeft), *FString::FromInt(NumUnloadsLeft));
 }
 
-bool UAssetStreamingSubsystem::RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId)
+void UAssetStreamingSubsystem::HandlePredictedRequest(const FSoftObjectPath& AssetPath)
 {
-	CheckThis();
+	// The request took its own handle on the asset, the prefetch doesn't need to hold it anymore.
+	FAssetStreamingPrefetch Prefetch;
+	if (Prefetches.RemoveAndCopyValue(AssetPath, Prefetch))
+	{
+		Prefetch.Handle->ReleaseHandle();
+		PrefetchStats.NumHits++;
+	}
 
-	// Assign a new guid to the request.
-	OutAssetRequestId = FGuid::NewGuid();
-	StreamAsset(AssetToStream, OutAssetRequestId, AssetLoadedCallback);
+	PredictionsScratch.Reset();
+	Predictor.Observe(AssetPath, FPlatformTime::Seconds(), PredictorMinConfidence, PredictionsScratch);
 
-	return OutAssetRequestId.IsValid();
+	for (const FSoftObjectPath& PredictedPath : PredictionsScratch)
+	{
+		PrefetchAsset(PredictedPath);
+	}
 }
 
-bool UAssetStreamingSubsystem::ReleaseAssets(FGuid& RequestId)
+void UAssetStreamingSubsystem::PrefetchAsset(const FSoftObjectPath& AssetPath)
 {
-	CheckThis();
+	// Nothing to gain from assets that are already tracked, loaded or prefetched.
+	if (Prefetches.Num() >= MaxPrefetches || Prefetches.Contains(AssetPath) || RecordIndices.Contains(AssetPath) || AssetPath.ResolveObject()) return;
 
-	if (!RequestId.IsValid())
+	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetPath, FStreamableDelegate(), GetAsyncLoadPriority(EAssetStreamingPriority::Background), false);
+	if (!Handle.IsValid()) return;
+
+	FAssetStreamingPrefetch& Prefetch = Prefetches.Add(AssetPath);
+	Prefetch.Handle = Handle;
+	Prefetch.ExpireTime = FPlatformTime::Seconds() + PrefetchTimeoutSeconds;
+	PrefetchExpiries.Add(TPair<FSoftObjectPath, double>(AssetPath, Prefetch.ExpireTime));
+	PrefetchStats.NumIssued++;
+
+	UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Prefetching predicted asset '%s'."), *AssetPath.GetAssetName());
+}
+
+void UAssetStreamingSubsystem::ExpirePrefetches()
+{
+	// Prefetches expire in the order they were issued. Entries of adopted prefetches are skipped.
+	const double Now = FPlatformTime::Seconds();
+	while (NextPrefetchExpiry < PrefetchExpiries.Num())
 	{
-		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to release assets using an invalid Guid."));
-		return false;
+		const TPair<FSoftObjectPath, double>& Expiry = PrefetchExpiries[NextPrefetchExpiry];
+		const FAssetStreamingPrefetch* Prefetch = Prefetches.Find(Expiry.Key);
+		if (Prefetch && Prefetch->ExpireTime == Expiry.Value)
+		{
+			if (Expiry.Value > Now) break;
+
+			if (UObject* Object = Expiry.Key.ResolveObject())
+			{
+				PrefetchStats.WastedBytes += Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+			PrefetchStats.NumWasted++;
+
+			Prefetch->Handle->ReleaseHandle();
+			Prefetches.Remove(Expiry.Key);
+		}
+		NextPrefetchExpiry++;
 	}
+	CompactPumpQueue(PrefetchExpiries, NextPrefetchExpiry);
+}
 
-	if (!RegisteredAssets.Contains(RequestId))
+void UAssetStreamingSubsystem::DropPrefetches()
+{
+	for (const TPair<FSoftObjectPath, FAssetStreamingPrefetch>& Prefetch : Prefetches)
 	{
-		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to release assets using id '%s' but it leads to no assets."), *RequestId.ToString());
-		RequestId.Invalidate();
-		return false;
+		Prefetch.Value.Handle->ReleaseHandle();
 	}
 
-	FAssetHandleArray Assets = RegisteredAssets[RequestId];
+	Prefetches.Empty();
+	PrefetchExpiries.Empty();
+	NextPrefetchExpiry = 0;
+}
 
-	// Decrement the amount of references to each of these assets.
-	for (int Index = Assets.Num() - 1; Index >= 0; Index--)
+void UAssetStreamingSubsystem::DispatchCompletion(const FAssetStreamingCompletion& Completion)
+{
+	if (!Completion.Batch.IsValid())
 	{
-		FAssetHandlePair& Pair = Assets[Index];
-		TSoftObjectPtr<UObject> Asset = Pair.Asset;
-		FSoftObjectPath AssetPath = Asset.ToSoftObjectPath();
-
-		checkf(AssetRequestCount.Contains(AssetPath), TEXT("Attempted to release asset '%s' but we're not tracking it's count."), *Asset.GetAssetName());
-		checkf(!Asset.IsNull(), TEXT("Attempted to release null asset."));
-		checkf(Pair.Handle.Get(), TEXT("Asset handle is null."));
+		// Released requests aren't called back.
+		if (FindRequest(Completion.Waiter.RequestHandle))
+		{
+			HandleAssetLoaded(Completion.Waiter.Asset, Completion.Waiter.Callback, Completion.Waiter.bWasAlreadyLoaded, Completion.Waiter.bIsExcluded);
+		}
+		return;
+	}
 
-		AssetRequestCount[AssetPath]--;
+	FAssetStreamingBatch& Batch = *Completion.Batch;
+	if (Completion.AssetIndex != INDEX_NONE)
+	{
+		if (!FindRequest(Batch.RequestHandle)) return;
 
-		// If we still have references to this asset, remove it from the array since we're going to re-use it to schedule unloading.
-		if (AssetRequestCount[AssetPath] > 0) Assets.RemoveAt(Index);
-		// If not, we just remove it from the asset request map.
-		else AssetRequestCount.Remove(AssetPath);
+		const TSoftObjectPtr<UObject>& Asset = Batch.Assets[Completion.AssetIndex];
+		HandleAssetLoaded(Asset, Batch.Callback, Batch.WasAlreadyLoaded[Completion.AssetIndex], Batch.Excluded[Completion.AssetIndex]);
 
-		// If the handle of this asset isn't the one to keep alive, cancel it immediately.
-		if (Pair.Handle != KeepAlive[AssetPath])
+		if (Batch.OnAssetLoaded)
 		{
-			UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Handle to release isn't keep-alive, cancelling it."));
-			Pair.Handle.Get()->CancelHandle();
+			Batch.OnAssetLoaded(Asset.Get(), Batch.WasAlreadyLoaded[Completion.AssetIndex]);
 		}
-		else
+		return;
+	}
+
+	// Native requests get every asset in request order, null if it failed to load.
+	if (Batch.OnRequestLoaded)
+	{
+		// Take the completion out of the batch, releasing what it captured once we're done. Released requests don't call it.
+		FAssetRequestLoadedFunction OnRequestLoaded = MoveTemp(Batch.OnRequestLoaded);
+		if (!FindRequest(Batch.RequestHandle)) return;
+
+		TArray<UObject*> LoadedObjects;
+		LoadedObjects.Reserve(Batch.Assets.Num());
+		for (const TSoftObjectPtr<UObject>& Asset : Batch.Assets)
 		{
-			UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Handle to release is keep-alive, skipping it."));
+			LoadedObjects.Add(Asset.Get());
 		}
+
+		OnRequestLoaded(LoadedObjects);
+		return;
 	}
 
-	// Remove the registered assets for this request id.
-	RegisteredAssets.Remove(RequestId);
+	if (!FindRequest(Batch.RequestHandle)) return;
 
-	// Any asset remaining in the assets array needs to be scheduled for unloading.
-	if (Assets.Num() == 0)
+	TArray<TSoftObjectPtr<UObject>> LoadedAssets;
+	LoadedAssets.Reserve(Batch.Assets.Num());
+
+	for (int32 Index = 0; Index < Batch.Assets.Num(); Index++)
 	{
-		UE_LOG(LogAssetStreaming, Verbose, TEXT("Finished releasing assets without any need for unloading. Request id: '%s'"), *RequestId.ToString());
-		RequestId.Invalidate();
-		return true;
+		if (Batch.Notified[Index]) LoadedAssets.Add(Batch.Assets[Index]);
 	}
 
-	// Schedule all assets for unloading. Unload will happen after a delay, to verify that no other objects need the assets one more time.
-	ScheduleAssetUnloading(Assets);
-
-	UE_LOG(LogAssetStreaming, Verbose, TEXT("Scheduled %s assets for unloading. Request id: '%s'"), *FString::FromInt(Assets.Num()), *RequestId.ToString());
-	RequestId.Invalidate();
+	if (LoadedAssets.Num() != Batch.Assets.Num())
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("%s asset(s) out of %s failed to load in batch."), *FString::FromInt(Batch.Assets.Num() - LoadedAssets.Num()), *FString::FromInt(Batch.Assets.Num()));
+	}
 
-	return true;
+	if (Batch.Callback.GetObject() && Batch.Callback.GetObject()->IsValidLowLevel())
+	{
+		IAssetStreamingCallback::Execute_OnAssetBatchLoaded(Batch.Callback.GetObject(), LoadedAssets);
+	}
 }
 
-bool UAssetStreamingSubsystem::K2_RequestMultipleAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId)
+void UAssetStreamingSubsystem::HandleAssetLoaded(const TSoftObjectPtr<UObject>& LoadedAsset, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const bool bAlreadyLoaded, const bool bIsExcluded)
 {
-	return RequestAssetStreaming(AssetsToStream, nullptr, OutAssetRequestId);
+	if ((LoadedAsset.IsValid() || bIsExcluded) && AssetLoadedCallback.GetObject() && AssetLoadedCallback.GetObject()->IsValidLowLevel())
+	{
+		IAssetStreamingCallback::Execute_OnAssetLoaded(AssetLoadedCallback.GetObject(), LoadedAsset, bAlreadyLoaded);
+	}
 }
 
-bool UAssetStreamingSubsystem::K2_RequestMultipleAssetStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId)
+bool UAssetStreamingSubsystem::IsAssetClassExcluded(const FSoftObjectPath& AssetPath)
 {
-	return RequestAssetStreaming(AssetsToStream, AssetLoadedCallback, OutAssetRequestId);
+	const FName NetModeName = GetNetModeName();
+	const int32 FilterIndex = ClassFilters.IndexOfByPredicate([NetModeName](const FAssetStreamingClassFilter& Filter) { return Filter.NetMode == NetModeName; });
+	if (FilterIndex == INDEX_NONE || !AssetRegistry) return false;
+
+	if (FilterIndex != CachedClassFilterIndex)
+	{
+		ExcludedClassCache.Reset();
+		CachedClassFilterIndex = FilterIndex;
+	}
+
+	// Assets the registry doesn't know about are loaded as usual.
+	const FAssetData AssetData = AssetRegistry->GetAssetByObjectPath(AssetPath.GetAssetPathName());
+	if (!AssetData.IsValid()) return false;
+
+	if (const bool* bIsCachedExcluded = ExcludedClassCache.Find(AssetData.AssetClass))
+	{
+		return *bIsCachedExcluded;
+	}
+
+	// Subclasses of excluded classes are excluded too, i.e. Texture2D when Texture is.
+	TArray<FName> ClassNames;
+	AssetRegistry->GetAncestorClassNames(AssetData.AssetClass, ClassNames);
+	ClassNames.Add(AssetData.AssetClass);
+
+	const TArray<FName>& ExcludedClasses = ClassFilters[FilterIndex].ExcludedClasses;
+	const bool bIsExcluded = ClassNames.ContainsByPredicate([&ExcludedClasses](const FName ClassName) { return ExcludedClasses.Contains(ClassName); });
+
+	ExcludedClassCache.Add(AssetData.AssetClass, bIsExcluded);
+	return bIsExcluded;
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, FGuid& OutAssetRequestId)
+FName UAssetStreamingSubsystem::GetNetModeName() const
 {
-	return RequestAssetStreaming(AssetToStream, nullptr, OutAssetRequestId);
+	// The game instance may not have a world yet while it is initialized.
+	const UGameInstance* GameInstance = GetGameInstance();
+	const UWorld* World = GameInstance ? GameInstance->GetWorld() : nullptr;
+	const ENetMode NetMode = World ? World->GetNetMode() : (IsRunningDedicatedServer() ? NM_DedicatedServer : NM_Standalone);
+
+	switch (NetMode)
+	{
+	case NM_DedicatedServer:
+		return TEXT("DedicatedServer");
+	case NM_ListenServer:
+		return TEXT("ListenServer");
+	case NM_Client:
+		return TEXT("Client");
+	default:
+		return TEXT("Standalone");
+	}
 }
 
-bool UAssetStreamingSubsystem::K2_RequestAssetStreamingWithCallback(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId)
+void UAssetStreamingSubsystem::InitializeClassPolicies()
 {
-	return RequestAssetStreaming(AssetToStream, AssetLoadedCallback, OutAssetRequestId);
+	// A policy without a class nor a path prefix would catch every asset, the subsystem's settings are there for that.
+	const int32 NumInvalidPolicies = ClassPolicies.RemoveAll([](const FAssetStreamingClassPolicy& Policy) { return Policy.AssetClass.IsNone() && Policy.PathPrefix.IsEmpty(); });
+	if (NumInvalidPolicies > 0)
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Ignoring %s class policies that have neither an asset class nor a path prefix."), *FString::FromInt(NumInvalidPolicies));
+	}
+
+	for (FAssetStreamingClassPolicy& Policy : ClassPolicies)
+	{
+		if (Policy.UnloadDelaySeconds < 0.0f)
+		{
+			UE_LOG(LogAssetStreaming, Error, TEXT("The UnloadDelaySeconds of a class policy cannot be a negative number. Setting it to 5 seconds."));
+			Policy.UnloadDelaySeconds = 5.0f;
+		}
+
+		if (Policy.MaxWarmCacheBytes < 0)
+		{
+			UE_LOG(LogAssetStreaming, Error, TEXT("The MaxWarmCacheBytes of a class policy cannot be a negative number. Disabling its warm cache."));
+			Policy.MaxWarmCacheBytes = 0;
+		}
+	}
+
+	PolicyWarmCaches.SetNum(ClassPolicies.Num());
+	PolicyClassCache.Reset();
+
+	// Policies by class read the class of requested assets from the asset registry.
+	if (!AssetRegistry && ClassPolicies.ContainsByPredicate([](const FAssetStreamingClassPolicy& Policy) { return !Policy.AssetClass.IsNone(); }))
+	{
+		AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	}
 }
 
-bool UAssetStreamingSubsystem::K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId)
+int32 UAssetStreamingSubsystem::FindClassPolicy(const FSoftObjectPath& AssetPath)
 {
-	return ReleaseAssets(RequestId);
+	// Assets the registry doesn't know about only match policies by path.
+	const TBitArray<>* ClassMatches = nullptr;
+	if (AssetRegistry)
+	{
+		const FAssetData AssetData = AssetRegistry->GetAssetByObjectPath(AssetPath.GetAssetPathName());
+		if (AssetData.IsValid())
+		{
+			ClassMatches = PolicyClassCache.Find(AssetData.AssetClass);
+			if (!ClassMatches)
+			{
+				// Subclasses match the policies of their ancestors, i.e. SoundCue when SoundBase has one.
+				TArray<FName> ClassNames;
+				AssetRegistry->GetAncestorClassNames(AssetData.AssetClass, ClassNames);
+				ClassNames.Add(AssetData.AssetClass);
+
+				TBitArray<> Matches(false, ClassPolicies.Num());
+				for (int32 PolicyIndex = 0; PolicyIndex < ClassPolicies.Num(); PolicyIndex++)
+				{
+					Matches[PolicyIndex] = ClassNames.Contains(ClassPolicies[PolicyIndex].AssetClass);
+				}
+
+				ClassMatches = &PolicyClassCache.Add(AssetData.AssetClass, MoveTemp(Matches));
+			}
+		}
+	}
+
+	const FString PathString = AssetPath.ToString();
+	for (int32 PolicyIndex = 0; PolicyIndex < ClassPolicies.Num(); PolicyIndex++)
+	{
+		const FAssetStreamingClassPolicy& Policy = ClassPolicies[PolicyIndex];
+		const bool bClassMatches = Policy.AssetClass.IsNone() || (ClassMatches && (*ClassMatches)[PolicyIndex]);
+		const bool bPathMatches = Policy.PathPrefix.IsEmpty() || PathString.StartsWith(Policy.PathPrefix);
+
+		if (bClassMatches && bPathMatches) return PolicyIndex;
+	}
+
+	return INDEX_NONE;
 }
 
-void UAssetStreamingSubsystem::StreamAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FGuid& RequestId, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback)
+void UAssetStreamingSubsystem::HandleBatchUpdated(const TSharedRef<FAssetStreamingBatch>& Batch)
 {
-	checkf(!AssetToStream.IsNull(), TEXT("Attempted to stream null soft object pointer."));
+	for (int32 Index = 0; Index < Batch->Assets.Num(); Index++)
+	{
+		if (Batch->Notified[Index] || !Batch->Assets[Index].IsValid()) continue;
 
-	// Request an asynchronous load of the asset, even if the asset is already loaded. We'll keep the handle.
-	FStreamableDelegate OnLoaded;
-	const bool bIsAssetLoaded = AssetToStream.IsValid();
-	OnLoaded.BindLambda([this, AssetToStream, AssetLoadedCallback, bIsAssetLoaded]() { HandleAssetLoaded(AssetToStream, AssetLoadedCallback, bIsAssetLoaded); });
-	TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(AssetToStream.ToSoftObjectPath(), OnLoaded, FStreamableManager::DefaultAsyncLoadPriority, true);
+		Batch->Notified[Index] = true;
+		RecordLoadLatency(Batch->Assets[Index], Batch->WasAlreadyLoaded[Index], Batch->RequestTime);
 
-	// Register the asset and its handle to the request Id.
-	RegisterAssetToId(AssetToStream, Handle, RequestId);
+		if (const int32* RecordIndex = RecordIndices.Find(Batch->Assets[Index].ToSoftObjectPath()))
+		{
+			MeasureResidentBytes(*RecordIndex);
+		}
 
-	// We need to keep one handle alive at all times so that we choose when to unload the asset.
-	// To do this, we keep the first handle for each asset and never unload it until we really want to release the asset.
-	if (!KeepAlive.Contains(AssetToStream.ToSoftObjectPath()))
+		if (Batch->Callback.GetObject() || Batch->OnAssetLoaded)
+		{
+			PendingCompletions.Add(FAssetStreamingCompletion(Batch, Index));
+		}
+
+		// Requests may be waiting for an asset that this batch keeps alive.
+		if (NumLoadWaiters > 0) NotifyLoadWaiters(Batch->Assets[Index].ToSoftObjectPath());
+	}
+}
+
+void UAssetStreamingSubsystem::HandleBatchLoaded(const TSharedRef<FAssetStreamingBatch>& Batch)
+{
+	if (Batch->bIsInFlight)
+	{
+		Batch->bIsInFlight = false;
+		NumInFlightLoads--;
+	}
+
+	// Notify any asset the update delegate didn't catch.
+	HandleBatchUpdated(Batch);
+
+	// Call back the requests waiting for assets that failed to load.
+	for (int32 Index = 0; Index < Batch->Assets.Num() && NumLoadWaiters > 0; Index++)
 	{
-		KeepAlive.Add(AssetToStream.ToSoftObjectPath(), Handle);
+		if (!Batch->Notified[Index]) NotifyLoadWaiters(Batch->Assets[Index].ToSoftObjectPath());
 	}
 
-	// Increment the number of references for the asset.
-	IncrementAssetReference(AssetToStream);
+	// The whole batch is called back after each of its assets.
+	PendingCompletions.Add(FAssetStreamingCompletion(Batch, INDEX_NONE));
 }
 
-void UAssetStreamingSubsystem::RegisterAssetToId(const TSoftObjectPtr<UObject>& Asset, const TSharedPtr<FStreamableHandle> Handle, const FGuid& Id)
+bool UAssetStreamingSubsystem::IsKeepAliveHandle(const TSharedPtr<FStreamableHandle>& Handle, const int32 RecordIndex)
 {
-	FAssetHandlePair AssetPair = FAssetHandlePair(Asset, Handle);
+	// Most handles are the keep-alive handle of the asset they were requested for.
+	if (Records.IsValidIndex(RecordIndex) && Records[RecordIndex].KeepAlive == Handle) return true;
+
+	// Batch handles can keep other assets alive, check all of them.
+	RequestedAssetsScratch.Reset();
+	Handle->GetRequestedAssets(RequestedAssetsScratch);
+	if (RequestedAssetsScratch.Num() <= 1) return false;
 
-	if (RegisteredAssets.Contains(Id))
+	for (const FSoftObjectPath& RequestedAsset : RequestedAssetsScratch)
 	{
-		if (RegisteredAssets[Id].Contains(AssetPair))
-		{
-			UE_LOG(LogAssetStreaming, Error, TEXT("Attempted to register asset '%s' to Id '%s' but it already exists there."), *Asset.GetAssetName(), *Id.ToString());
-			return;
-		}
+		const int32* OtherIndex = RecordIndices.Find(RequestedAsset);
+		if (OtherIndex && Records[*OtherIndex].KeepAlive == Handle) return true;
+	}
+
+	return false;
+}
+
+void UAssetStreamingSubsystem::ScheduleAssetUnloading(const int32 RecordIndex, const bool bUnloadNow)
+{
+	// Each asset gets a single entry in the unload queue. Requesting the asset again clears the serial, cancelling it.
+	FAssetStreamingRecord& Record = Records[RecordIndex];
+	Record.State = EAssetRecordState::PendingUnload;
+	NumPendingUnloads++;
 
-		RegisteredAssets[Id].Add(AssetPair);
+	// Policies may keep cheap assets around for longer, or give heavy ones back as soon as memory runs low.
+	float DelaySeconds = UnloadDelaySeconds;
+	if (bUnloadNow)
+	{
+		DelaySeconds = 0.0f;
 	}
-	else
+	else if (Record.PolicyIndex != INDEX_NONE)
+	{
+		const FAssetStreamingClassPolicy& Policy = ClassPolicies[Record.PolicyIndex];
+		DelaySeconds = Policy.bUnloadUnderMemoryPressure && IsUnderMemoryPressure() ? 0.0f : Policy.UnloadDelaySeconds;
+	}
+
+	Record.UnloadSerial = UnloadQueue.Schedule(RecordIndex, FPlatformTime::Seconds() + DelaySeconds);
+}
+
+void UAssetStreamingSubsystem::CacheReleasedAsset(const int32 RecordIndex)
+{
+	// Assets released before they finished loading have no size yet and nothing to keep warm, unload them normally.
+	FAssetStreamingRecord& Record = Records[RecordIndex];
+	if (!Record.AssetPath.ResolveObject())
 	{
-		FAssetHandleArray Array;
-		Array.Add(AssetPair);
-		RegisteredAssets.Add(Id, Array);
+		ScheduleAssetUnloading(RecordIndex);
+		return;
 	}
-	UE_LOG(LogAssetStreaming, Verbose, TEXT("Registered asset '%s' to Id '%s'."), *Asset.GetAssetName(), *Id.ToString());
+
+	// The size measured when the asset was loaded, so that the cache budget agrees with the resident memory stat.
+	Record.State = EAssetRecordState::Cached;
+	Record.CacheSlot = GetWarmCache(Record.PolicyIndex).Add(RecordIndex, Record.ResidentBytes);
 }
 
-void UAssetStreamingSubsystem::IncrementAssetReference(const TSoftObjectPtr<UObject>& Asset)
+void UAssetStreamingSubsystem::EnforceWarmCacheBudget(const bool bFlush)
 {
-	checkf(!Asset.IsNull(), TEXT("Cannot increment asset reference of null asset."));
-	FSoftObjectPath AssetPath = Asset.ToSoftObjectPath();
+	const bool bIsUnderPressure = bFlush || IsUnderMemoryPressure();
 
-	if (AssetRequestCount.Contains(AssetPath))
+	TArray<int32> EvictedAssets;
+	EvictFromWarmCache(WarmCache, WarmCacheBudgetBytes, bIsUnderPressure, EvictedAssets);
+
+	// Trims flush every cache. Polled memory pressure spares the policies opting out of it, they only evict past their own budget.
+	for (int32 PolicyIndex = 0; PolicyIndex < PolicyWarmCaches.Num(); PolicyIndex++)
 	{
-		AssetRequestCount[AssetPath]++;
+		const bool bEvictAll = bFlush || (bIsUnderPressure && ClassPolicies[PolicyIndex].bUnloadUnderMemoryPressure);
+		EvictFromWarmCache(PolicyWarmCaches[PolicyIndex], ClassPolicies[PolicyIndex].MaxWarmCacheBytes, bEvictAll, EvictedAssets);
 	}
-	else
+
+	if (EvictedAssets.Num() == 0) return;
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Evicting %s assets from the warm caches. %s assets remain cached."), *FString::FromInt(EvictedAssets.Num()), *FString::FromInt(GetNumWarmCachedAssets()));
+
+	// Large eviction waves would spike the frame. The pump unloads them within its budget, like expired unloads, and requesting them again cancels the unload.
+	for (const int32 RecordIndex : EvictedAssets)
 	{
-		AssetRequestCount.Add(AssetPath, 1);
+		ScheduleAssetUnloading(RecordIndex, true);
 	}
 }
 
-void UAssetStreamingSubsystem::HandleAssetLoaded(const TSoftObjectPtr<UObject>& LoadedAsset, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const bool& bAlreadyLoaded)
+void UAssetStreamingSubsystem::EvictFromWarmCache(FAssetWarmCache& Cache, const int64 BudgetBytes, const bool bEvictAll, TArray<int32>& OutEvictedAssets)
 {
-	if (LoadedAsset.IsValid() && AssetLoadedCallback.GetObject()->IsValidLowLevel())
+	int32 RecordIndex = INDEX_NONE;
+
+	while (Cache.Num() > 0 && (bEvictAll || Cache.GetTotalBytes() > BudgetBytes))
 	{
-		IAssetStreamingCallback::Execute_OnAssetLoaded(AssetLoadedCallback.GetObject(), LoadedAsset, bAlreadyLoaded);
+		Cache.EvictOldest(RecordIndex);
+		Records[RecordIndex].CacheSlot = INDEX_NONE;
+		OutEvictedAssets.Add(RecordIndex);
 	}
 }
 
-void UAssetStreamingSubsystem::ScheduleAssetUnloading(const FAssetHandleArray& Assets)
+int32 UAssetStreamingSubsystem::GetNumWarmCachedAssets() const
 {
-	if (Assets.Num() == 0)
+	int32 NumCachedAssets = WarmCache.Num();
+	for (const FAssetWarmCache& Cache : PolicyWarmCaches)
 	{
-		UE_LOG(LogAssetStreaming, Warning, TEXT("Attempted to schedule asset unloading with an empty array."));
-		return;
+		NumCachedAssets += Cache.Num();
 	}
 
-	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
-	FTimerHandle Handle;
-	FTimerDelegate Delegate;
-	Delegate.BindLambda([this, Assets]() { FinalUnloadAssets(Assets); });
+	return NumCachedAssets;
+}
+
+bool UAssetStreamingSubsystem::IsUnderMemoryPressure()
+{
+	if (MemoryPressureAvailableBytes <= 0) return false;
+
+	// Polling the platform isn't free, only do it once per second at most. Report the last result in between.
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastMemoryPressureCheckTime < 1.0) return bIsUnderMemoryPressure;
+	LastMemoryPressureCheckTime = Now;
+
+	const FPlatformMemoryStats Stats = FPlatformMemory::GetStats();
+	bIsUnderMemoryPressure = Stats.AvailablePhysical < static_cast<uint64>(MemoryPressureAvailableBytes);
+	return bIsUnderMemoryPressure;
+}
+
+void UAssetStreamingSubsystem::HandleMemoryTrim()
+{
+	UE_LOG(LogAssetStreaming, Log, TEXT("Platform requested a memory trim, flushing %s assets from the warm caches."), *FString::FromInt(GetNumWarmCachedAssets()));
+	EnforceWarmCacheBudget(true);
+	DropPrefetches();
+
+	// The platform wants the memory back now, not when the threshold is reached. Collect once the pump has unloaded the evicted assets.
+	bIsTrimReclaimPending = ReclaimThresholdBytes > 0;
+}
+
+void UAssetStreamingSubsystem::RequestReclaim()
+{
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReclaimTime < MinReclaimIntervalSeconds || !GEngine) return;
+	LastReclaimTime = Now;
+
+	UE_LOG(LogAssetStreaming, Verbose, TEXT("Requesting a garbage collection to reclaim %s KB of unloaded assets."), *FString::FromInt(UnreachableBytes / 1024));
 
-	TimerManager.SetTimer(Handle, Delegate, UnloadDelaySeconds, false);
+	// The engine collects at the start of its next tick, outside of any object iteration. Without a full purge, objects are purged incrementally.
+	GEngine->ForceGarbageCollection(false);
+	NumReclaims++;
 }
 
-void UAssetStreamingSubsystem::FinalUnloadAssets(const FAssetHandleArray& Assets)
+void UAssetStreamingSubsystem::FinalUnloadAsset(const int32 RecordIndex)
 {
-	// If this somehow runs while the game is quitting, ignore.
-	if (!this) return;
+	// Requesting an asset again takes it out of the unload queue and the warm cache, so every asset here can be unloaded.
+	FAssetStreamingRecord& Record = Records[RecordIndex];
+	checkf(Record.RequestCount == 0, TEXT("Attempted to unload asset '%s' but it is still referenced."), *Record.AssetPath.GetAssetName());
+
+	UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Unloading asset '%s'."), *Record.AssetPath.GetAssetName());
 
-	int32 UnloadedAssetsCount = 0;
-	for (FAssetHandlePair Pair : Assets)
+	if (Record.State == EAssetRecordState::PendingUnload) NumPendingUnloads--;
+	NumLoadWaiters -= Record.Waiters.Num();
+
+	if (bIsRecordingTrace)
 	{
-		TSoftObjectPtr<UObject> Asset = Pair.Asset;
-		checkf(!Asset.IsNull(), TEXT("Attempted to unload null asset pointer."));
+		Trace.RecordUnloaded(FPlatformTime::Seconds(), Record.AssetPath);
+	}
 
-		FSoftObjectPath AssetPath = Asset.ToSoftObjectPath();
+	const int64 ResidentBytes = Record.ResidentBytes;
+	SetResidentBytes(RecordIndex, 0);
 
-		// Check if a new request to this asset was made. If so, we won't unload it.
-		if (AssetRequestCount.Contains(AssetPath)) continue;
+	// Stop tracking the asset, keeping its handle until we're done.
+	TSharedPtr<FStreamableHandle> Handle = MoveTemp(Record.KeepAlive);
+	RecordIndices.Remove(Record.AssetPath);
+	Records.RemoveAt(RecordIndex);
 
-		UE_LOG(LogAssetStreaming, VeryVerbose, TEXT("Unloading asset '%s'."), *Asset.GetAssetName());
+	if (!Handle.IsValid())
+	{
+		UE_LOG(LogAssetStreaming, Error, TEXT("Unloaded an asset that had no keep-alive handle. We should at least find one?"));
+		UnreachableBytes += ResidentBytes;
+		return;
+	}
 
-		// Remove the handle from the KeepAlive array.
-		KeepAlive.Remove(AssetPath);
+	NumKeepAliveHandles--;
 
-		// Get the active handles for the asset and cancel them. Normally, we should only find one.
-		// Cancelling will also stop them from completing if they haven't been loaded yet. The callback won't be called.
-		TArray<TSharedRef<FStreamableHandle>> ActiveHandles;
-		if (StreamableManager.GetActiveHandles(AssetPath, ActiveHandles, true))
-		{
-			for (TSharedRef<FStreamableHandle> Handle : ActiveHandles)
-			{
-				Handle.Get().CancelHandle();
-			}
+	// Cancel the keep-alive handle. Cancelling will also stop it from completing if it hasn't been loaded yet. The callback won't be called.
+	// A batch handle that still keeps other assets alive is left untouched: the asset will be unloaded along with the last asset of the batch.
+	if (IsKeepAliveHandle(Handle, INDEX_NONE)) return;
 
-			UnloadedAssetsCount++;
-		}
-		else
-		{
-			UE_LOG(LogAssetStreaming, Error, TEXT("Attempted to unload asset '%s' but no active handles were found. We should at least find one?"), *Asset.GetAssetName());
-		}
+	CancelHandle(Handle);
+
+	// The asset stays in memory until the next garbage collection. Assets still held by their batch return early and aren't counted,
+	// so that we never request collections that free nothing, at the cost of leaving them out once the batch is cancelled.
+	UnreachableBytes += ResidentBytes;
+}
+
+void UAssetStreamingSubsystem::CancelHandle(const TSharedPtr<FStreamableHandle>& Handle)
+{
+	// Cancelled handles never call their loaded delegate, so they stop being in flight right away.
+	if (Handle->IsLoadingInProgress()) NumInFlightLoads--;
+	Handle->CancelHandle();
+}
+
+void UAssetStreamingSubsystem::UpdateStats()
+{
+	const uint32 NumRequestedAssets = NumAlreadyLoadedHits + NumLoadMisses;
+	const float HitRate = NumRequestedAssets > 0 ? 100.0f * NumAlreadyLoadedHits / NumRequestedAssets : 0.0f;
+
+	SET_DWORD_STAT(STAT_AssetStreaming_TrackedAssets, Records.Num());
+	SET_DWORD_STAT(STAT_AssetStreaming_KeepAliveHandles, NumKeepAliveHandles);
+	SET_DWORD_STAT(STAT_AssetStreaming_PendingUnloads, NumPendingUnloads);
+	SET_DWORD_STAT(STAT_AssetStreaming_WarmCachedAssets, GetNumWarmCachedAssets());
+	SET_DWORD_STAT(STAT_AssetStreaming_InFlightLoads, NumInFlightLoads);
+	SET_DWORD_STAT(STAT_AssetStreaming_StreamingComponents, ProximityEntries.Num());
+	SET_FLOAT_STAT(STAT_AssetStreaming_ResidentMB, TrackedResidentBytes / (1024.0f * 1024.0f));
+	SET_FLOAT_STAT(STAT_AssetStreaming_UnreachableMB, UnreachableBytes / (1024.0f * 1024.0f));
+	SET_DWORD_STAT(STAT_AssetStreaming_ExcludedAssets, NumExcludedAssets);
+	SET_DWORD_STAT(STAT_AssetStreaming_StaleRequests, NumStaleRequests);
+	SET_FLOAT_STAT(STAT_AssetStreaming_StalePinnedMB, StalePinnedBytes / (1024.0f * 1024.0f));
+	SET_DWORD_STAT(STAT_AssetStreaming_ExpandedDependencies, NumExpandedDependencies);
+	SET_DWORD_STAT(STAT_AssetStreaming_Prefetches, Prefetches.Num());
+	SET_FLOAT_STAT(STAT_AssetStreaming_PrefetchAccuracy, 100.0f * PrefetchStats.GetAccuracy());
+	SET_FLOAT_STAT(STAT_AssetStreaming_PrefetchWastedMB, PrefetchStats.WastedBytes / (1024.0f * 1024.0f));
+	SET_DWORD_STAT(STAT_AssetStreaming_PendingCompletions, PendingCompletions.Num() - NextCompletionIndex);
+	SET_DWORD_STAT(STAT_AssetStreaming_UnloadBacklog, ExpiredUnloads.Num() - NextExpiredUnloadIndex);
+	SET_DWORD_STAT(STAT_AssetStreaming_PumpFramesBehind, NumPumpFramesBehind);
+	SET_FLOAT_STAT(STAT_AssetStreaming_HitRate, HitRate);
+	SET_FLOAT_STAT(STAT_AssetStreaming_AverageLatency, LatencyHistogram.GetAverageMs());
+
+	CSV_CUSTOM_STAT(AssetStreaming, TrackedAssets, Records.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, KeepAliveHandles, NumKeepAliveHandles, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, PendingUnloads, NumPendingUnloads, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, WarmCachedAssets, GetNumWarmCachedAssets(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, InFlightLoads, NumInFlightLoads, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, StreamingComponents, ProximityEntries.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, ResidentMB, TrackedResidentBytes / (1024.0f * 1024.0f), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, UnreachableMB, UnreachableBytes / (1024.0f * 1024.0f), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, ExcludedAssets, NumExcludedAssets, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, StaleRequests, NumStaleRequests, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, StalePinnedMB, StalePinnedBytes / (1024.0f * 1024.0f), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, ExpandedDependencies, NumExpandedDependencies, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, Prefetches, Prefetches.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, PrefetchAccuracy, 100.0f * PrefetchStats.GetAccuracy(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, PrefetchWastedMB, PrefetchStats.WastedBytes / (1024.0f * 1024.0f), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, PendingCompletions, PendingCompletions.Num() - NextCompletionIndex, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, UnloadBacklog, ExpiredUnloads.Num() - NextExpiredUnloadIndex, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, PumpFramesBehind, NumPumpFramesBehind, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AssetStreaming, HitRate, HitRate, ECsvCustomStatOp::Set);
+}
+
+FAssetStreamingPumpBacklog UAssetStreamingSubsystem::GetPumpBacklog() const
+{
+	FAssetStreamingPumpBacklog Backlog;
+	Backlog.NumCompletions = PendingCompletions.Num() - NextCompletionIndex;
+	Backlog.NumUnloads = ExpiredUnloads.Num() - NextExpiredUnloadIndex;
+	Backlog.NumFramesBehind = NumPumpFramesBehind;
+	return Backlog;
+}
+
+SIZE_T UAssetStreamingSubsystem::GetAllocatedSize() const
+{
+	SIZE_T Size = Records.GetAllocatedSize() + RecordIndices.GetAllocatedSize() + FreeRequestSlots.GetAllocatedSize()
+		+ WarmCache.GetAllocatedSize() + UnloadQueue.GetAllocatedSize()
+		+ ExpiredUnloads.GetAllocatedSize() + PendingCompletions.GetAllocatedSize() + ReleasedRecords.GetAllocatedSize() + RequestedAssetsScratch.GetAllocatedSize()
+		+ ProximityGrid.GetAllocatedSize() + ProximityEntries.GetAllocatedSize() + ActiveProximityEntries.GetAllocatedSize()
+		+ ProximityCandidates.GetAllocatedSize() + ProximityQueryScratch.GetAllocatedSize()
+		+ StartupManifestPaths.GetAllocatedSize() + RecordedStartupPaths.GetAllocatedSize() + PendingPreloadPaths.GetAllocatedSize()
+		+ Predictor.GetAllocatedSize() + Prefetches.GetAllocatedSize() + PrefetchExpiries.GetAllocatedSize() + PredictionsScratch.GetAllocatedSize()
+		+ Trace.GetAllocatedSize() + LoadOrder.GetAllocatedSize() + PendingLoads.GetAllocatedSize() + PendingLoadsScratch.GetAllocatedSize()
+		+ ExcludedClassCache.GetAllocatedSize() + PolicyClassCache.GetAllocatedSize() + PolicyWarmCaches.GetAllocatedSize()
+		+ Dependencies.GetAllocatedSize();
+
+	for (const FAssetWarmCache& Cache : PolicyWarmCaches)
+	{
+		Size += Cache.GetAllocatedSize();
+	}
+
+	// Requests keep a few assets inline, their asset arrays only allocate beyond that.
+	Size += Requests.GetAllocatedSize();
+	for (const FAssetStreamingRequest& Request : Requests)
+	{
+		Size += Request.Assets.GetAllocatedSize();
 	}
 
-	UE_LOG(LogAssetStreaming, Verbose, TEXT("Finally unloaded %s assets."), *FString::FromInt(UnloadedAssetsCount));
+	return Size;
 }
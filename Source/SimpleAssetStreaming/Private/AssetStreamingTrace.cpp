@@ -0,0 +1,215 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingTrace.h"
+#include "AssetStreamingFileFormat.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "SimpleAssetStreaming.h"
+
+FString FAssetStreamingTrace::GetDefaultFilename()
+{
+	return FPaths::ProjectSavedDir() / TEXT("AssetStreaming") / TEXT("Trace.bin");
+}
+
+void FAssetStreamingTrace::Reset(const double Now)
+{
+	AssetPaths.Reset();
+	AssetIndices.Reset();
+	Entries.Reset();
+	StartTime = Now;
+}
+
+void FAssetStreamingTrace::RecordRequest(const double Now, const uint32 RequestId, const FSoftObjectPath& AssetPath)
+{
+	AddEntry(Now, EAssetStreamingTraceEvent::Request, RequestId, FindOrAddAsset(AssetPath), 0);
+}
+
+void FAssetStreamingTrace::RecordRelease(const double Now, const uint32 RequestId)
+{
+	AddEntry(Now, EAssetStreamingTraceEvent::Release, RequestId, INDEX_NONE, 0);
+}
+
+void FAssetStreamingTrace::RecordLoaded(const double Now, const FSoftObjectPath& AssetPath, const int64 SizeBytes)
+{
+	AddEntry(Now, EAssetStreamingTraceEvent::Loaded, 0, FindOrAddAsset(AssetPath), SizeBytes);
+}
+
+void FAssetStreamingTrace::RecordUnloaded(const double Now, const FSoftObjectPath& AssetPath)
+{
+	AddEntry(Now, EAssetStreamingTraceEvent::Unloaded, 0, FindOrAddAsset(AssetPath), 0);
+}
+
+int32 FAssetStreamingTrace::FindOrAddAsset(const FSoftObjectPath& AssetPath)
+{
+	// Hash the path only once, whether the asset was traced before or not.
+	const uint32 PathHash = GetTypeHash(AssetPath);
+	if (const int32* FoundIndex = AssetIndices.FindByHash(PathHash, AssetPath))
+	{
+		return *FoundIndex;
+	}
+
+	const int32 AssetIndex = AssetPaths.Add(AssetPath);
+	AssetIndices.AddByHash(PathHash, AssetPath, AssetIndex);
+
+	return AssetIndex;
+}
+
+void FAssetStreamingTrace::AddEntry(const double Now, const EAssetStreamingTraceEvent Type, const uint32 RequestId, const int32 AssetIndex, const int64 SizeBytes)
+{
+	FAssetStreamingTraceEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Time = FMath::Max(Now - StartTime, 0.0);
+	Entry.Type = Type;
+	Entry.RequestId = RequestId;
+	Entry.AssetIndex = AssetIndex;
+	Entry.SizeBytes = SizeBytes;
+}
+
+bool FAssetStreamingTrace::Save(const FString& Filename) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+
+	FAssetStreamingFileFormat::SaveHeader(Writer, Magic, Version);
+	FAssetStreamingFileFormat::SaveCount(Writer, AssetPaths.Num());
+	FAssetStreamingFileFormat::SaveCount(Writer, Entries.Num());
+	FAssetStreamingFileFormat::SaveAssetPaths(Writer, AssetPaths);
+
+	// Times are written in microseconds, relative to the previous event. Deltas are taken from the rounded times so that errors don't add up.
+	uint64 PreviousMicroseconds = 0;
+	for (const FAssetStreamingTraceEntry& Entry : Entries)
+	{
+		const uint64 Microseconds = FMath::Max(static_cast<uint64>(Entry.Time * 1.0e6 + 0.5), PreviousMicroseconds);
+		uint32 Delta = static_cast<uint32>(FMath::Min<uint64>(Microseconds - PreviousMicroseconds, MAX_uint32));
+		PreviousMicroseconds += Delta;
+
+		uint8 Type = static_cast<uint8>(Entry.Type);
+		Writer << Type;
+		Writer.SerializeIntPacked(Delta);
+
+		if (Entry.Type == EAssetStreamingTraceEvent::Request || Entry.Type == EAssetStreamingTraceEvent::Release)
+		{
+			uint32 RequestId = Entry.RequestId;
+			Writer.SerializeIntPacked(RequestId);
+		}
+
+		if (Entry.Type != EAssetStreamingTraceEvent::Release)
+		{
+			uint32 AssetIndex = static_cast<uint32>(Entry.AssetIndex);
+			Writer.SerializeIntPacked(AssetIndex);
+		}
+
+		if (Entry.Type == EAssetStreamingTraceEvent::Loaded)
+		{
+			int64 SizeBytes = Entry.SizeBytes;
+			Writer << SizeBytes;
+		}
+	}
+
+	return FFileHelper::SaveArrayToFile(Data, *Filename);
+}
+
+bool FAssetStreamingTrace::Load(const FString& Filename)
+{
+	Reset(0.0);
+
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Filename, FILEREAD_Silent)) return false;
+
+	FMemoryReader Reader(Data);
+
+	int32 NumAssetPaths = 0;
+	int32 NumEntries = 0;
+	if (!FAssetStreamingFileFormat::LoadHeader(Reader, Magic, Version)
+		|| !FAssetStreamingFileFormat::LoadCount(Reader, FAssetStreamingFileFormat::MaxAssetPaths, NumAssetPaths)
+		|| !FAssetStreamingFileFormat::LoadCount(Reader, MaxEntries, NumEntries))
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Ignoring invalid asset streaming trace '%s'."), *Filename);
+		return false;
+	}
+
+	bool bIsValid = FAssetStreamingFileFormat::LoadAssetPaths(Reader, NumAssetPaths, AssetPaths);
+
+	AssetIndices.Reserve(AssetPaths.Num());
+	for (int32 AssetIndex = 0; AssetIndex < AssetPaths.Num(); AssetIndex++)
+	{
+		AssetIndices.Add(AssetPaths[AssetIndex], AssetIndex);
+	}
+
+	// Duplicate paths would make events reference the wrong asset.
+	bIsValid = bIsValid && AssetIndices.Num() == NumAssetPaths;
+
+	Entries.Reserve(NumEntries);
+	uint64 Microseconds = 0;
+	for (int32 Index = 0; Index < NumEntries && bIsValid && !Reader.IsError(); Index++)
+	{
+		uint8 Type = 0;
+		uint32 Delta = 0;
+		uint32 RequestId = 0;
+		uint32 AssetIndex = MAX_uint32;
+		int64 SizeBytes = 0;
+
+		Reader << Type;
+		Reader.SerializeIntPacked(Delta);
+		Microseconds += Delta;
+
+		if (Type > static_cast<uint8>(EAssetStreamingTraceEvent::Unloaded))
+		{
+			bIsValid = false;
+			break;
+		}
+
+		const EAssetStreamingTraceEvent EventType = static_cast<EAssetStreamingTraceEvent>(Type);
+		if (EventType == EAssetStreamingTraceEvent::Request || EventType == EAssetStreamingTraceEvent::Release)
+		{
+			Reader.SerializeIntPacked(RequestId);
+		}
+
+		if (EventType != EAssetStreamingTraceEvent::Release)
+		{
+			Reader.SerializeIntPacked(AssetIndex);
+			bIsValid = AssetIndex < static_cast<uint32>(NumAssetPaths);
+		}
+
+		if (EventType == EAssetStreamingTraceEvent::Loaded)
+		{
+			Reader << SizeBytes;
+		}
+
+		AddEntry(Microseconds * 1.0e-6, EventType, RequestId, EventType == EAssetStreamingTraceEvent::Release ? INDEX_NONE : static_cast<int32>(AssetIndex), SizeBytes);
+	}
+
+	if (!bIsValid || Reader.IsError())
+	{
+		UE_LOG(LogAssetStreaming, Warning, TEXT("Ignoring truncated or corrupted asset streaming trace '%s'."), *Filename);
+		Reset(0.0);
+		return false;
+	}
+
+	return true;
+}
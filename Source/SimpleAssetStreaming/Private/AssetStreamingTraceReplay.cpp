@@ -0,0 +1,276 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingTraceReplay.h"
+#include "AssetStreamingTrace.h"
+#include "AssetUnloadQueue.h"
+#include "AssetWarmCache.h"
+
+// The simulated state of a traced asset, standing in for its record.
+struct FAssetStreamingReplayAsset
+{
+	FAssetStreamingReplayAsset()
+		: SizeBytes(0)
+		, RequestCount(0)
+		, LoadedTime(0.0)
+		, LoadSerial(0)
+		, UnloadSerial(0)
+		, CacheSlot(INDEX_NONE)
+		, bIsTracked(false)
+		, bIsLoaded(false)
+		, bWasLoaded(false)
+	{}
+
+	// The largest size the trace measured for the asset. Zero if it was never measured.
+	int64 SizeBytes;
+
+	int32 RequestCount;
+
+	// When the pending load of the asset completes.
+	double LoadedTime;
+
+	// The serial of the pending load. Zero once the load is cancelled.
+	uint32 LoadSerial;
+
+	// The serial of the pending unload. Zero once the asset is requested again.
+	uint32 UnloadSerial;
+
+	int32 CacheSlot;
+
+	bool bIsTracked;
+
+	bool bIsLoaded;
+
+	// Whether the asset was loaded then unloaded earlier in the trace, making its next load a reload.
+	bool bWasLoaded;
+};
+
+// A single replay of a trace. Follows the subsystem's request, release and unload paths, with simulated loads.
+class FAssetStreamingReplaySimulation
+{
+public:
+
+	FAssetStreamingReplaySimulation(const FAssetStreamingTrace& InTrace, const FAssetStreamingReplayPolicy& InPolicy, const FAssetStreamingReplayLatency& InLatency)
+		: Trace(InTrace)
+		, Policy(InPolicy)
+		, Latency(InLatency)
+		, Assets()
+		, ActiveRequests()
+		, PendingLoads()
+		, UnloadQueue()
+		, WarmCache()
+		, CompletedLoads()
+		, ExpiredUnloads()
+		, TrackedBytes(0)
+		, Result()
+	{
+		Assets.SetNum(Trace.GetAssetPaths().Num());
+
+		for (const FAssetStreamingTraceEntry& Entry : Trace.GetEntries())
+		{
+			if (Entry.Type == EAssetStreamingTraceEvent::Loaded)
+			{
+				Assets[Entry.AssetIndex].SizeBytes = FMath::Max(Assets[Entry.AssetIndex].SizeBytes, Entry.SizeBytes);
+			}
+		}
+	}
+
+	FAssetStreamingReplayResult Run()
+	{
+		for (const FAssetStreamingTraceEntry& Entry : Trace.GetEntries())
+		{
+			Advance(Entry.Time);
+
+			if (Entry.Type == EAssetStreamingTraceEvent::Request)
+			{
+				Request(Entry.Time, Entry.RequestId, Entry.AssetIndex);
+			}
+			else if (Entry.Type == EAssetStreamingTraceEvent::Release)
+			{
+				Release(Entry.Time, Entry.RequestId);
+			}
+		}
+
+		// Loads still pending at the end of the trace count towards the peak.
+		Advance(TNumericLimits<double>::Max());
+
+		return Result;
+	}
+
+private:
+
+	// Completes the loads and unloads due by a point in time, in the order they're due.
+	void Advance(const double Now)
+	{
+		PendingLoads.PopExpired(Now, CompletedLoads);
+		UnloadQueue.PopExpired(Now, ExpiredUnloads);
+
+		int32 NextLoad = 0;
+		int32 NextUnload = 0;
+		while (NextLoad < CompletedLoads.Num() || NextUnload < ExpiredUnloads.Num())
+		{
+			const bool bIsLoadFirst = NextUnload >= ExpiredUnloads.Num() || (NextLoad < CompletedLoads.Num() && CompletedLoads[NextLoad].Deadline <= ExpiredUnloads[NextUnload].Deadline);
+			if (bIsLoadFirst)
+			{
+				CompleteLoad(CompletedLoads[NextLoad++]);
+			}
+			else
+			{
+				const FAssetUnloadQueue::FEntry& Entry = ExpiredUnloads[NextUnload++];
+
+				// Stale entries of assets requested again are skipped, like the subsystem does.
+				if (Assets[Entry.RecordIndex].UnloadSerial == Entry.Serial) Unload(Entry.RecordIndex);
+			}
+		}
+
+		CompletedLoads.Reset();
+		ExpiredUnloads.Reset();
+	}
+
+	void Request(const double Now, const uint32 RequestId, const int32 AssetIndex)
+	{
+		ActiveRequests.FindOrAdd(RequestId).Add(AssetIndex);
+		Result.NumRequestedAssets++;
+
+		FAssetStreamingReplayAsset& Asset = Assets[AssetIndex];
+		if (Asset.bIsLoaded)
+		{
+			Result.NumHits++;
+		}
+		else if (Asset.bIsTracked)
+		{
+			// Share the pending load.
+			Result.TotalWaitSeconds += Asset.LoadedTime - Now;
+		}
+		else
+		{
+			const double LoadSeconds = Latency.GetLoadSeconds(Asset.SizeBytes);
+			Asset.bIsTracked = true;
+			Asset.LoadedTime = Now + LoadSeconds;
+			Asset.LoadSerial = PendingLoads.Schedule(AssetIndex, Asset.LoadedTime);
+			Result.TotalWaitSeconds += LoadSeconds;
+			Result.NumLoads++;
+			if (Asset.bWasLoaded) Result.NumReloads++;
+		}
+
+		// Take the asset back from the warm cache or the unload queue if it was released earlier.
+		if (Asset.CacheSlot != INDEX_NONE)
+		{
+			WarmCache.Remove(Asset.CacheSlot);
+			Asset.CacheSlot = INDEX_NONE;
+		}
+		Asset.UnloadSerial = 0;
+		Asset.RequestCount++;
+	}
+
+	void Release(const double Now, const uint32 RequestId)
+	{
+		// Requests the trace started recording after, or that failed before registering anything, have nothing to release.
+		const TArray<int32>* RequestAssets = ActiveRequests.Find(RequestId);
+		if (!RequestAssets) return;
+
+		for (const int32 AssetIndex : *RequestAssets)
+		{
+			FAssetStreamingReplayAsset& Asset = Assets[AssetIndex];
+			if (--Asset.RequestCount > 0) continue;
+
+			// Assets released before they finished loading have nothing to keep warm, unload them normally.
+			if (Policy.WarmCacheBudgetBytes > 0 && Asset.bIsLoaded)
+			{
+				Asset.CacheSlot = WarmCache.Add(AssetIndex, Asset.SizeBytes);
+			}
+			else
+			{
+				Asset.UnloadSerial = UnloadQueue.Schedule(AssetIndex, Now + Policy.UnloadDelaySeconds);
+			}
+		}
+		ActiveRequests.Remove(RequestId);
+
+		int32 EvictedIndex = INDEX_NONE;
+		while (WarmCache.GetTotalBytes() > Policy.WarmCacheBudgetBytes && WarmCache.EvictOldest(EvictedIndex))
+		{
+			Assets[EvictedIndex].CacheSlot = INDEX_NONE;
+			Unload(EvictedIndex);
+		}
+	}
+
+	void CompleteLoad(const FAssetUnloadQueue::FEntry& Entry)
+	{
+		// Loads of assets unloaded in the meantime were cancelled.
+		FAssetStreamingReplayAsset& Asset = Assets[Entry.RecordIndex];
+		if (Asset.LoadSerial != Entry.Serial) return;
+
+		Asset.LoadSerial = 0;
+		Asset.bIsLoaded = true;
+		TrackedBytes += Asset.SizeBytes;
+		Result.PeakTrackedBytes = FMath::Max(Result.PeakTrackedBytes, TrackedBytes);
+	}
+
+	void Unload(const int32 AssetIndex)
+	{
+		FAssetStreamingReplayAsset& Asset = Assets[AssetIndex];
+		if (Asset.bIsLoaded) TrackedBytes -= Asset.SizeBytes;
+
+		Asset.bWasLoaded |= Asset.bIsLoaded;
+		Asset.bIsTracked = false;
+		Asset.bIsLoaded = false;
+		Asset.LoadSerial = 0;
+		Asset.UnloadSerial = 0;
+	}
+
+	const FAssetStreamingTrace& Trace;
+
+	const FAssetStreamingReplayPolicy& Policy;
+
+	const FAssetStreamingReplayLatency& Latency;
+
+	// Indexed like the asset paths of the trace.
+	TArray<FAssetStreamingReplayAsset> Assets;
+
+	// The assets registered to each active request, keyed by request slot.
+	TMap<uint32, TArray<int32>> ActiveRequests;
+
+	// Simulated loads, sorted by completion time. Uses the same deadline queue as the unloads.
+	FAssetUnloadQueue PendingLoads;
+
+	FAssetUnloadQueue UnloadQueue;
+
+	FAssetWarmCache WarmCache;
+
+	// Scratch arrays reused by every advance.
+	TArray<FAssetUnloadQueue::FEntry> CompletedLoads;
+	TArray<FAssetUnloadQueue::FEntry> ExpiredUnloads;
+
+	int64 TrackedBytes;
+
+	FAssetStreamingReplayResult Result;
+};
+
+FAssetStreamingReplayResult FAssetStreamingTraceReplay::Run(const FAssetStreamingTrace& Trace, const FAssetStreamingReplayPolicy& Policy, const FAssetStreamingReplayLatency& Latency)
+{
+	FAssetStreamingReplaySimulation Simulation(Trace, Policy, Latency);
+	return Simulation.Run();
+}
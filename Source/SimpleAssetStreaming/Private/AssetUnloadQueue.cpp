@@ -0,0 +1,52 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetUnloadQueue.h"
+
+uint32 FAssetUnloadQueue::Schedule(const int32 RecordIndex, const double Deadline)
+{
+	// Zero is reserved for records that aren't pending unload.
+	const uint32 Serial = NextSerial;
+	NextSerial = NextSerial == MAX_uint32 ? 1 : NextSerial + 1;
+
+	FEntry Entry;
+	Entry.Deadline = Deadline;
+	Entry.RecordIndex = RecordIndex;
+	Entry.Serial = Serial;
+	Heap.HeapPush(Entry, FEntryPredicate());
+
+	return Serial;
+}
+
+void FAssetUnloadQueue::PopExpired(const double Now, TArray<FEntry>& OutEntries)
+{
+	FEntry Entry;
+	while (Heap.Num() > 0 && Heap.HeapTop().Deadline <= Now)
+	{
+		Heap.HeapPop(Entry, FEntryPredicate(), false);
+		OutEntries.Add(Entry);
+	}
+}
@@ -0,0 +1,69 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetWarmCache.h"
+
+int32 FAssetWarmCache::Add(const int32 RecordIndex, const int64 SizeBytes)
+{
+	FEntry Entry;
+	Entry.RecordIndex = RecordIndex;
+	Entry.SizeBytes = SizeBytes;
+	Entry.Newer = INDEX_NONE;
+	Entry.Older = Newest;
+
+	const int32 Slot = Entries.Add(Entry);
+	if (Newest != INDEX_NONE) Entries[Newest].Newer = Slot;
+	if (Oldest == INDEX_NONE) Oldest = Slot;
+	Newest = Slot;
+
+	TotalBytes += SizeBytes;
+
+	return Slot;
+}
+
+void FAssetWarmCache::Remove(const int32 Slot)
+{
+	const FEntry& Entry = Entries[Slot];
+
+	if (Entry.Newer != INDEX_NONE) Entries[Entry.Newer].Older = Entry.Older;
+	else Newest = Entry.Older;
+
+	if (Entry.Older != INDEX_NONE) Entries[Entry.Older].Newer = Entry.Newer;
+	else Oldest = Entry.Newer;
+
+	TotalBytes -= Entry.SizeBytes;
+	Entries.RemoveAt(Slot);
+}
+
+bool FAssetWarmCache::EvictOldest(int32& OutRecordIndex)
+{
+	if (Oldest == INDEX_NONE) return false;
+
+	OutRecordIndex = Entries[Oldest].RecordIndex;
+	Remove(Oldest);
+
+	return true;
+}
@@ -0,0 +1,274 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingTestUtils.h"
+#include "AssetStreamingComponent.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "SimpleAssetStreaming.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static constexpr uint32 AssetStreamingBenchmarkFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+/**
+ * Request/release cycles over a synthetic asset set, run a chunk per frame.
+ * Each cycle makes a request of one to four assets and releases the oldest of the outstanding requests.
+ * Assets are in-memory objects, so the benchmark measures the bookkeeping of the subsystem rather than the loader.
+ */
+class FAssetStreamingBenchmark
+{
+public:
+
+	static constexpr int32 NumCycles = 100000;
+	static constexpr int32 CyclesPerFrame = 10000;
+	static constexpr int32 NumSyntheticAssets = 1024;
+	static constexpr int32 NumOutstandingRequests = 64;
+	static constexpr int32 MaxAssetsPerRequest = 4;
+
+	// The subsystem is ticked this often, unloading every released asset.
+	static constexpr int32 CyclesPerTick = 64;
+
+	FAssetStreamingBenchmark(const bool bInUseBatches)
+		: bUseBatches(bInUseBatches)
+		, Subsystem(nullptr)
+		, Random(0x5A5)
+		, NextOutstandingRequest(0)
+		, CompletedCycles(0)
+		, ElapsedCycles(0)
+		, NumAllocations(0)
+		, PeakAllocatedSize(0)
+		, PeakResidentBytes(0)
+	{
+		Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+		FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+		Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(NumSyntheticAssets, Objects);
+		OutstandingRequests.SetNum(NumOutstandingRequests);
+		RequestAssets.Reserve(MaxAssetsPerRequest);
+	}
+
+	// Runs the cycles of a frame. Returns true once every cycle is done.
+	bool RunChunk()
+	{
+		const int32 LastCycle = FMath::Min(CompletedCycles + CyclesPerFrame, NumCycles);
+		const uint64 StartAllocations = GetAllocationCount();
+		const uint64 StartTime = FPlatformTime::Cycles64();
+
+		for (; CompletedCycles < LastCycle; CompletedCycles++)
+		{
+			// Pick consecutive assets, so that a request never holds the same asset twice.
+			const int32 FirstAsset = Random.RandHelper(NumSyntheticAssets);
+			const int32 NumAssets = Random.RandRange(1, MaxAssetsPerRequest);
+
+			RequestAssets.Reset();
+			for (int32 Offset = 0; Offset < NumAssets; Offset++)
+			{
+				RequestAssets.Add(Assets[(FirstAsset + Offset) % NumSyntheticAssets]);
+			}
+
+			FAssetStreamingRequestHandle& Slot = OutstandingRequests[NextOutstandingRequest];
+			NextOutstandingRequest = (NextOutstandingRequest + 1) % NumOutstandingRequests;
+
+			if (Slot.IsValid())
+			{
+				Subsystem->ReleaseAssets(Slot);
+			}
+
+			if (bUseBatches) Subsystem->RequestAssetBatchStreaming(RequestAssets, nullptr, Slot);
+			else Subsystem->RequestAssetStreaming(RequestAssets, nullptr, Slot);
+
+			if (CompletedCycles % CyclesPerTick == 0)
+			{
+				FAssetStreamingTestAccess::Tick(*Subsystem);
+				PeakAllocatedSize = FMath::Max(PeakAllocatedSize, Subsystem->GetAllocatedSize());
+				PeakResidentBytes = FMath::Max(PeakResidentBytes, Subsystem->GetTrackedResidentBytes());
+			}
+		}
+
+		ElapsedCycles += FPlatformTime::Cycles64() - StartTime;
+		NumAllocations += GetAllocationCount() - StartAllocations;
+
+		return CompletedCycles >= NumCycles;
+	}
+
+	// Releases the outstanding requests and reports the results of the benchmark.
+	void Finish(FAutomationTestBase& Test)
+	{
+		for (FAssetStreamingRequestHandle& RequestHandle : OutstandingRequests)
+		{
+			if (RequestHandle.IsValid()) Subsystem->ReleaseAssets(RequestHandle);
+		}
+		FAssetStreamingTestAccess::Tick(*Subsystem);
+
+		Test.TestEqual(TEXT("Every asset is unloaded once the requests are released"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+		const double NanosecondsPerOp = FPlatformTime::ToSeconds64(ElapsedCycles) * 1.0e9 / CompletedCycles;
+		const double AllocationsPerOp = static_cast<double>(NumAllocations) / CompletedCycles;
+
+		const FString Result = FString::Printf(TEXT("%s: %d request/release cycles, %.1f ns/op, %.3f allocations/op, peak bookkeeping %llu bytes, peak resident assets %lld bytes."),
+			bUseBatches ? TEXT("Batch requests") : TEXT("Requests"), CompletedCycles, NanosecondsPerOp, AllocationsPerOp, static_cast<uint64>(PeakAllocatedSize), PeakResidentBytes);
+
+		UE_LOG(LogAssetStreaming, Display, TEXT("%s"), *Result);
+		Test.AddInfo(Result);
+	}
+
+	UAssetStreamingSubsystem* GetSubsystem() const { return Subsystem; }
+
+	const TArray<UObject*>& GetObjects() const { return Objects; }
+
+private:
+
+	// Returns the number of allocations made so far. Zero if the allocator doesn't count them.
+	static uint64 GetAllocationCount()
+	{
+#if !UE_BUILD_SHIPPING
+		return FMalloc::TotalMallocCalls + FMalloc::TotalReallocCalls;
+#else
+		return 0;
+#endif
+	}
+
+	bool bUseBatches;
+
+	UAssetStreamingSubsystem* Subsystem;
+
+	TArray<UObject*> Objects;
+
+	TArray<TSoftObjectPtr<UObject>> Assets;
+
+	TArray<TSoftObjectPtr<UObject>> RequestAssets;
+
+	// Ring of outstanding requests, the oldest one is released by every cycle.
+	TArray<FAssetStreamingRequestHandle> OutstandingRequests;
+
+	FRandomStream Random;
+
+	int32 NextOutstandingRequest;
+
+	int32 CompletedCycles;
+
+	uint64 ElapsedCycles;
+
+	uint64 NumAllocations;
+
+	// The memory of the subsystem's bookkeeping, excluding the assets.
+	SIZE_T PeakAllocatedSize;
+
+	// The memory of the tracked assets.
+	int64 PeakResidentBytes;
+};
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FAssetStreamingBenchmarkCommand, TSharedRef<FAssetStreamingBenchmark>, Benchmark, FAutomationTestBase*, Test);
+
+bool FAssetStreamingBenchmarkCommand::Update()
+{
+	if (!Benchmark->RunChunk()) return false;
+
+	Benchmark->Finish(*Test);
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Benchmark->GetSubsystem(), Benchmark->GetObjects()));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingRequestBenchmark, "SimpleAssetStreaming.Benchmark.RequestRelease", AssetStreamingBenchmarkFlags)
+
+bool FAssetStreamingRequestBenchmark::RunTest(const FString& Parameters)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingBenchmarkCommand(MakeShared<FAssetStreamingBenchmark>(false), this));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingBatchBenchmark, "SimpleAssetStreaming.Benchmark.BatchRequestRelease", AssetStreamingBenchmarkFlags)
+
+bool FAssetStreamingBatchBenchmark::RunTest(const FString& Parameters)
+{
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingBenchmarkCommand(MakeShared<FAssetStreamingBenchmark>(true), this));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingProximityBenchmark, "SimpleAssetStreaming.Benchmark.Proximity", AssetStreamingBenchmarkFlags)
+
+// A view crossing an open world holding 20k streaming components, measuring the time spent ticking the subsystem.
+bool FAssetStreamingProximityBenchmark::RunTest(const FString& Parameters)
+{
+	static constexpr int32 GridSize = 142;
+	static constexpr float Spacing = 2000.0f;
+	static constexpr int32 NumFrames = 300;
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(1024, Objects);
+
+	for (int32 Index = 0; Index < GridSize * GridSize; Index++)
+	{
+		UAssetStreamingComponent* Component = NewObject<UAssetStreamingComponent>(GetTransientPackage());
+		Component->Assets.Add(Assets[Index % Assets.Num()]);
+		Component->StreamingOffset = FVector((Index % GridSize) * Spacing, (Index / GridSize) * Spacing, 0.0f);
+		Component->AddToRoot();
+		Objects.Add(Component);
+
+		Subsystem->RegisterStreamingComponent(Component);
+	}
+
+	uint64 TotalCycles = 0;
+	uint64 MaxCycles = 0;
+	for (int32 Frame = 0; Frame < NumFrames; Frame++)
+	{
+		const float Distance = GridSize * Spacing * Frame / NumFrames;
+		Subsystem->SetViewLocationsOverride({ FVector(Distance, Distance, 0.0f) });
+
+		const uint64 StartTime = FPlatformTime::Cycles64();
+		FAssetStreamingTestAccess::Tick(*Subsystem);
+		const uint64 ElapsedCycles = FPlatformTime::Cycles64() - StartTime;
+
+		TotalCycles += ElapsedCycles;
+		MaxCycles = FMath::Max(MaxCycles, ElapsedCycles);
+	}
+
+	const FString Result = FString::Printf(TEXT("Proximity: %d components, %d frames, %.1f us/frame on average, %.1f us at most."),
+		GridSize * GridSize, NumFrames, FPlatformTime::ToSeconds64(TotalCycles) * 1.0e6 / NumFrames, FPlatformTime::ToSeconds64(MaxCycles) * 1.0e6);
+
+	UE_LOG(LogAssetStreaming, Display, TEXT("%s"), *Result);
+	AddInfo(Result);
+
+	for (UObject* Object : Objects)
+	{
+		if (UAssetStreamingComponent* Component = Cast<UAssetStreamingComponent>(Object))
+		{
+			Subsystem->UnregisterStreamingComponent(Component);
+		}
+	}
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+#endif
@@ -0,0 +1,1167 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "AssetStreamingTestUtils.h"
+#include "AssetStreamingComponent.h"
+#include "AssetStreamingDependencies.h"
+#include "AssetStreamingLoadOrder.h"
+#include "AssetStreamingPredictor.h"
+#include "AssetStreamingStartupManifest.h"
+#include "AssetStreamingTrace.h"
+#include "AssetStreamingTraceReplay.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static constexpr uint32 AssetStreamingTestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingRequestReleaseTest, "SimpleAssetStreaming.Subsystem.RequestReleaseUnload", AssetStreamingTestFlags)
+
+bool FAssetStreamingRequestReleaseTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Request succeeds"), Subsystem->RequestAssetStreaming(Assets, nullptr, RequestHandle));
+	TestTrue(TEXT("Request handle is valid"), RequestHandle.IsValid());
+	TestEqual(TEXT("Both assets are tracked"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 2);
+	TestEqual(TEXT("First asset has one reference"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+
+	TestTrue(TEXT("Release succeeds"), Subsystem->ReleaseAssets(RequestHandle));
+	TestFalse(TEXT("Request handle is invalidated by the release"), RequestHandle.IsValid());
+	TestEqual(TEXT("Both assets are pending unload"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 2u);
+	TestEqual(TEXT("Assets stay tracked until the unload delay expires"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 2);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Assets are unloaded once the delay expires"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+	TestEqual(TEXT("No unload is pending anymore"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 0u);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSharedReferencesTest, "SimpleAssetStreaming.Subsystem.SharedReferences", AssetStreamingTestFlags)
+
+bool FAssetStreamingSharedReferencesTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(1, Objects);
+
+	FAssetStreamingRequestHandle FirstHandle;
+	FAssetStreamingRequestHandle SecondHandle;
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, FirstHandle);
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, SecondHandle);
+	TestNotEqual(TEXT("Requests get different handles"), FirstHandle, SecondHandle);
+	TestEqual(TEXT("Asset has two references"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 2);
+
+	Subsystem->ReleaseAssets(FirstHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is still referenced by the second request"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+	TestEqual(TEXT("Asset isn't pending unload"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 0u);
+
+	// The first handle is stale now, even if its slot gets reused.
+	FAssetStreamingRequestHandle StaleHandle = FirstHandle;
+	FAssetStreamingRequestHandle ThirdHandle;
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, ThirdHandle);
+	TestFalse(TEXT("Stale handle can't release the request that reused its slot"), Subsystem->ReleaseAssets(StaleHandle));
+	TestEqual(TEXT("Asset has two references"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 2);
+
+	Subsystem->ReleaseAssets(SecondHandle);
+	Subsystem->ReleaseAssets(ThirdHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded once every request is released"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSharedKeepAliveTest, "SimpleAssetStreaming.Subsystem.SharedKeepAlive", AssetStreamingTestFlags)
+
+bool FAssetStreamingSharedKeepAliveTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(1, Objects);
+
+	// A popular asset requested by many actors only gets one streamable handle.
+	TArray<FAssetStreamingRequestHandle> RequestHandles;
+	RequestHandles.SetNum(500);
+	for (FAssetStreamingRequestHandle& RequestHandle : RequestHandles)
+	{
+		Subsystem->RequestAssetStreaming(Assets[0], nullptr, RequestHandle);
+	}
+
+	const FAssetStreamingRecord* Record = FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[0]);
+	if (TestNotNull(TEXT("Asset is tracked"), Record))
+	{
+		TestEqual(TEXT("Asset has a reference per request"), Record->RequestCount, 500);
+
+		int32 NumSharedHandles = 0;
+		for (const FAssetStreamingRequestHandle& RequestHandle : RequestHandles)
+		{
+			if (FAssetStreamingTestAccess::GetAssetHandle(*Subsystem, RequestHandle, 0) == Record->KeepAlive) NumSharedHandles++;
+		}
+		TestEqual(TEXT("Every request shares the keep-alive handle"), NumSharedHandles, 500);
+	}
+
+	// Releasing all but one request must not cancel the shared handle.
+	for (int32 Index = 1; Index < RequestHandles.Num(); Index++)
+	{
+		Subsystem->ReleaseAssets(RequestHandles[Index]);
+	}
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	Record = FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[0]);
+	if (TestNotNull(TEXT("Asset is still tracked"), Record))
+	{
+		TestEqual(TEXT("Asset has one reference left"), Record->RequestCount, 1);
+		TestTrue(TEXT("Keep-alive handle is still active"), Record->KeepAlive.IsValid() && !Record->KeepAlive->WasCanceled());
+	}
+
+	Subsystem->ReleaseAssets(RequestHandles[0]);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded once every request is released"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingReRequestDuringDelayTest, "SimpleAssetStreaming.Subsystem.ReRequestDuringUnloadDelay", AssetStreamingTestFlags)
+
+bool FAssetStreamingReRequestDuringDelayTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(1, Objects);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, RequestHandle);
+	Subsystem->ReleaseAssets(RequestHandle);
+	TestEqual(TEXT("Asset is pending unload"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 1u);
+
+	// Request the asset again before the subsystem ticks, its expired unload must be ignored.
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, RequestHandle);
+	TestEqual(TEXT("Asset isn't pending unload anymore"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 0u);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	const FAssetStreamingRecord* Record = FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[0]);
+	if (TestNotNull(TEXT("Asset is still tracked after the cancelled unload expired"), Record))
+	{
+		TestEqual(TEXT("Asset has one reference"), Record->RequestCount, 1);
+		TestTrue(TEXT("Asset is referenced"), Record->State == EAssetRecordState::Referenced);
+		TestTrue(TEXT("Asset still has its keep-alive handle"), Record->KeepAlive.IsValid());
+	}
+
+	Subsystem->ReleaseAssets(RequestHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded after the second release"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingBatchTest, "SimpleAssetStreaming.Subsystem.BatchRequest", AssetStreamingTestFlags)
+
+bool FAssetStreamingBatchTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+
+	// Duplicates within a batch are ignored with a warning.
+	Assets.Add(Assets[0]);
+	AddExpectedError(TEXT("present multiple times in the same batch"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Batch request succeeds"), Subsystem->RequestAssetBatchStreaming(Assets, nullptr, RequestHandle));
+	TestEqual(TEXT("Each asset is tracked once"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 3);
+	TestEqual(TEXT("Duplicate asset only has one reference"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+
+	Subsystem->ReleaseAssets(RequestHandle);
+	TestEqual(TEXT("Every asset of the batch is pending unload"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 3u);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Every asset of the batch is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingQueuedRequestsTest, "SimpleAssetStreaming.Subsystem.QueuedRequests", AssetStreamingTestFlags)
+
+bool FAssetStreamingQueuedRequestsTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	// Queue a request and a batch request from a worker thread.
+	TFuture<TArray<FAssetStreamingRequestHandle>> Future = Async(EAsyncExecution::ThreadPool, [Subsystem, Assets]()
+	{
+		TArray<FAssetStreamingRequestHandle> Handles;
+		Handles.Add(Subsystem->EnqueueAssetStreaming(Assets, nullptr));
+		Handles.Add(Subsystem->EnqueueAssetStreaming(Assets, nullptr, EAssetStreamingPriority::Normal, true));
+		return Handles;
+	});
+
+	const TArray<FAssetStreamingRequestHandle> Handles = Future.Get();
+	TestTrue(TEXT("Queued handles are returned right away"), Handles[0].IsValid() && Handles[0].IsQueued() && Handles[1].IsValid());
+	TestNotEqual(TEXT("Queued handles are unique"), Handles[0], Handles[1]);
+	TestEqual(TEXT("Nothing is requested before the subsystem ticks"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Queued requests are submitted on tick"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 2);
+
+	// Release one request from a worker thread, and the other one on the game thread.
+	Async(EAsyncExecution::ThreadPool, [Subsystem, Handles]() { Subsystem->EnqueueReleaseAssets(Handles[0]); }).Wait();
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Queued release is processed on tick"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+
+	FAssetStreamingRequestHandle BatchHandle = Handles[1];
+	TestTrue(TEXT("Queued handle can be released on the game thread"), Subsystem->ReleaseAssets(BatchHandle));
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Every asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingQueuedBulkReleaseTest, "SimpleAssetStreaming.Subsystem.QueuedBulkRelease", AssetStreamingTestFlags)
+
+bool FAssetStreamingQueuedBulkReleaseTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	UObject* Owner = NewObject<UObject>(GetTransientPackage());
+	Owner->AddToRoot();
+	Objects.Add(Owner);
+
+	FAssetStreamingRequestHandle QueuedHandle = Subsystem->EnqueueAssetStreaming(Assets, nullptr, EAssetStreamingPriority::Normal, false, FAssetStreamingRequestOptions(Owner));
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Queued request is mapped to its slot"), FAssetStreamingTestAccess::GetNumQueuedRequestHandles(*Subsystem), 1);
+
+	// Requests released in bulk forget their queued handle along with their slot.
+	TestEqual(TEXT("Queued request is released with its owner"), Subsystem->ReleaseAllForOwner(Owner), 1);
+	TestEqual(TEXT("Queued handle isn't mapped anymore"), FAssetStreamingTestAccess::GetNumQueuedRequestHandles(*Subsystem), 0);
+
+	// The thread that queued the request may still release it, from the queue or the game thread.
+	Subsystem->EnqueueReleaseAssets(QueuedHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestFalse(TEXT("Queued handle released in bulk doesn't resolve to the freed slot"), Subsystem->ReleaseAssets(QueuedHandle));
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Every asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingNativeCompletionTest, "SimpleAssetStreaming.Subsystem.NativeCompletion", AssetStreamingTestFlags)
+
+bool FAssetStreamingNativeCompletionTest::RunTest(const FString& Parameters)
+{
+	struct FState
+	{
+		int32 NumAssetCallbacks = 0;
+		int32 NumRequestCompletions = 0;
+		TArray<UObject*> CompletedAssets;
+		TFuture<TArray<UObject*>> Future;
+		TFuture<TArray<UObject*>> ReleasedFuture;
+	};
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+	TSharedRef<FState> State = MakeShared<FState>();
+
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Native request succeeds"), Subsystem->RequestAssetStreaming(Assets, RequestHandle,
+		[State](const TArray<UObject*>& LoadedAssets) { State->NumRequestCompletions++; State->CompletedAssets = LoadedAssets; },
+		EAssetStreamingPriority::Normal,
+		[State](UObject* LoadedAsset, bool bWasAlreadyLoaded) { State->NumAssetCallbacks++; }));
+
+	FAssetStreamingRequestHandle FutureHandle;
+	State->Future = Subsystem->RequestAssetStreamingAsync(Assets, FutureHandle);
+
+	// Releasing a request before it calls back resolves its future without assets.
+	FAssetStreamingRequestHandle ReleasedHandle;
+	State->ReleasedFuture = Subsystem->RequestAssetStreamingAsync(Assets, ReleasedHandle);
+	Subsystem->ReleaseAssets(ReleasedHandle);
+
+	// The streamable manager calls back on the next frame, even for assets that are already loaded. Callbacks are then dispatched when the subsystem ticks.
+	const double StartTime = FPlatformTime::Seconds();
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Subsystem, State, Objects, StartTime]()
+	{
+		FAssetStreamingTestAccess::Tick(*Subsystem);
+
+		const bool bIsReady = State->Future.IsReady() && State->ReleasedFuture.IsReady() && State->NumRequestCompletions > 0;
+		if (!bIsReady && FPlatformTime::Seconds() - StartTime < 5.0) return false;
+
+		TestEqual(TEXT("Completion is called once per request"), State->NumRequestCompletions, 1);
+		TestEqual(TEXT("Asset callback is called once per asset"), State->NumAssetCallbacks, 3);
+		TestEqual(TEXT("Completion receives the assets in request order"), State->CompletedAssets, Objects);
+		TestTrue(TEXT("Future is resolved"), State->Future.IsReady());
+		if (State->Future.IsReady()) TestEqual(TEXT("Future receives the assets in request order"), State->Future.Get(), Objects);
+		TestTrue(TEXT("Future of the released request is resolved"), State->ReleasedFuture.IsReady());
+		if (State->ReleasedFuture.IsReady()) TestEqual(TEXT("Future of the released request has no assets"), State->ReleasedFuture.Get().Num(), 0);
+
+		return true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingPumpBudgetTest, "SimpleAssetStreaming.Subsystem.PumpBudget", AssetStreamingTestFlags)
+
+bool FAssetStreamingPumpBudgetTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	// A budget this small only lets the pump unload one asset per frame.
+	FAssetStreamingTestAccess::SetPumpBudget(*Subsystem, 0.0001f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(100, Objects);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	Subsystem->RequestAssetStreaming(Assets, nullptr, RequestHandle);
+	Subsystem->ReleaseAssets(RequestHandle);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	const int32 NumTrackedAfterFirstTick = FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem);
+	const FAssetStreamingPumpBacklog Backlog = Subsystem->GetPumpBacklog();
+	TestTrue(TEXT("Pump makes progress even without budget"), NumTrackedAfterFirstTick < 100);
+	TestTrue(TEXT("Pump carries leftovers over to the next frame"), NumTrackedAfterFirstTick > 0 && Backlog.NumUnloads == NumTrackedAfterFirstTick);
+	TestEqual(TEXT("Pump reports being one frame behind"), Backlog.NumFramesBehind, 1u);
+
+	for (int32 Frame = 0; Frame < 1000 && FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem) > 0; Frame++)
+	{
+		FAssetStreamingTestAccess::Tick(*Subsystem);
+	}
+	TestEqual(TEXT("Every asset is eventually unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+	TestEqual(TEXT("Pump caught up"), Subsystem->GetPumpBacklog().NumFramesBehind, 0u);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingProximityTest, "SimpleAssetStreaming.Subsystem.Proximity", AssetStreamingTestFlags)
+
+bool FAssetStreamingProximityTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	// Components without an owner are placed at their streaming offset.
+	UAssetStreamingComponent* NearComponent = NewObject<UAssetStreamingComponent>(GetTransientPackage());
+	NearComponent->Assets.Add(Assets[0]);
+	NearComponent->EnterRadius = 100.0f;
+	NearComponent->ExitRadius = 200.0f;
+	NearComponent->AddToRoot();
+	Objects.Add(NearComponent);
+
+	UAssetStreamingComponent* FarComponent = NewObject<UAssetStreamingComponent>(GetTransientPackage());
+	FarComponent->Assets.Add(Assets[1]);
+	FarComponent->EnterRadius = 100.0f;
+	FarComponent->ExitRadius = 200.0f;
+	FarComponent->StreamingOffset = FVector(100000.0f, 0.0f, 0.0f);
+	FarComponent->AddToRoot();
+	Objects.Add(FarComponent);
+
+	Subsystem->RegisterStreamingComponent(NearComponent);
+	Subsystem->RegisterStreamingComponent(FarComponent);
+	Subsystem->SetViewLocationsOverride({ FVector(50.0f, 0.0f, 0.0f) });
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Component within the enter radius streams its assets"), NearComponent->IsStreamingAssets());
+	TestEqual(TEXT("Asset of the near component is requested"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+	TestFalse(TEXT("Component out of range doesn't stream its assets"), FarComponent->IsStreamingAssets());
+
+	// Between the enter and exit radii, the assets stay streamed.
+	Subsystem->SetViewLocationsOverride({ FVector(150.0f, 0.0f, 0.0f) });
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Assets aren't released before the exit radius"), NearComponent->IsStreamingAssets());
+
+	Subsystem->SetViewLocationsOverride({ FVector(250.0f, 0.0f, 0.0f) });
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestFalse(TEXT("Assets are released past the exit radius"), NearComponent->IsStreamingAssets());
+	TestEqual(TEXT("Asset of the near component is released"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 0);
+
+	// Evaluations are spread over multiple frames.
+	FAssetStreamingTestAccess::SetProximityEvaluationsPerTick(*Subsystem, 1);
+	Subsystem->SetViewLocationsOverride({ FVector::ZeroVector, FVector(100000.0f, 0.0f, 0.0f) });
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Only one component is evaluated per tick"), NearComponent->IsStreamingAssets() != FarComponent->IsStreamingAssets());
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Both components stream once the cycle is done"), NearComponent->IsStreamingAssets() && FarComponent->IsStreamingAssets());
+
+	// Unregistering releases the assets.
+	Subsystem->UnregisterStreamingComponent(NearComponent);
+	Subsystem->UnregisterStreamingComponent(FarComponent);
+	TestFalse(TEXT("Unregistered components don't stream anymore"), NearComponent->IsStreamingAssets() || FarComponent->IsStreamingAssets());
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Every asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingProximityReleasedRequestTest, "SimpleAssetStreaming.Subsystem.ProximityReleasedRequest", AssetStreamingTestFlags)
+
+bool FAssetStreamingProximityReleasedRequestTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(1, Objects);
+
+	UAssetStreamingComponent* Component = NewObject<UAssetStreamingComponent>(GetTransientPackage());
+	Component->Assets.Add(Assets[0]);
+	Component->EnterRadius = 100.0f;
+	Component->AddToRoot();
+	Objects.Add(Component);
+
+	Subsystem->RegisterStreamingComponent(Component);
+	Subsystem->SetViewLocationsOverride({ FVector::ZeroVector });
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Component in range streams its assets"), Component->IsStreamingAssets());
+
+	// The component owns its request, which can be released without it knowing.
+	TestEqual(TEXT("Request of the component is released with its owner"), Subsystem->ReleaseAllForOwner(Component), 1);
+	TestEqual(TEXT("Asset isn't referenced anymore"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 0);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Component in range streams again"), Component->IsStreamingAssets());
+	TestEqual(TEXT("Asset is requested again"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 1);
+
+	Subsystem->UnregisterStreamingComponent(Component);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Every asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingMemoryAccountingTest, "SimpleAssetStreaming.Subsystem.MemoryAccounting", AssetStreamingTestFlags)
+
+bool FAssetStreamingMemoryAccountingTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+	FAssetStreamingTestAccess::SetMemoryWatermarks(*Subsystem, { 1000 });
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+
+	// Two weapon requests share an asset, the UI request holds the last one.
+	const TArray<TSoftObjectPtr<UObject>> WeaponAssets = { Assets[0], Assets[1] };
+	FAssetStreamingRequestHandle FirstWeapons;
+	FAssetStreamingRequestHandle SecondWeapons;
+	FAssetStreamingRequestHandle Interface;
+	Subsystem->RequestAssetStreaming(WeaponAssets, nullptr, FirstWeapons, EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, TEXT("Weapons")));
+	Subsystem->RequestAssetStreaming(Assets[1], nullptr, SecondWeapons, EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, TEXT("Weapons")));
+	Subsystem->RequestAssetStreaming(Assets[2], nullptr, Interface, EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, TEXT("UI")));
+
+	FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Assets[0], 100);
+	FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Assets[1], 200);
+	FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Assets[2], 1000);
+
+	TestEqual(TEXT("Every tracked asset is accounted for"), Subsystem->GetTrackedResidentBytes(), static_cast<int64>(1300));
+	TestEqual(TEXT("Request accounts for each of its assets"), Subsystem->GetRequestResidentBytes(FirstWeapons), static_cast<int64>(300));
+
+	TArray<FAssetStreamingOwnerMemory> Owners;
+	Subsystem->GetTopMemoryOwners(0, Owners);
+	if (TestEqual(TEXT("Requests are grouped by tag"), Owners.Num(), 2))
+	{
+		TestEqual(TEXT("Largest owner comes first"), Owners[0].Owner, FName(TEXT("UI")));
+		TestEqual(TEXT("Shared assets are counted once per owner"), Owners[1].ResidentBytes, static_cast<int64>(300));
+		TestEqual(TEXT("Owner counts its requests"), Owners[1].NumRequests, 2);
+		TestEqual(TEXT("Owner counts its distinct assets"), Owners[1].NumAssets, 2);
+	}
+
+	// The watermark is reported once, until the tracked assets drop below it again.
+	AddExpectedError(TEXT("rose above the 1000 bytes watermark"), EAutomationExpectedErrorFlags::Contains, 1);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+
+	Subsystem->ReleaseAssets(Interface);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Unloaded assets aren't accounted for anymore"), Subsystem->GetTrackedResidentBytes(), static_cast<int64>(300));
+
+	Subsystem->ReleaseAssets(FirstWeapons);
+	Subsystem->ReleaseAssets(SecondWeapons);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingBulkReleaseTest, "SimpleAssetStreaming.Subsystem.BulkRelease", AssetStreamingTestFlags)
+
+bool FAssetStreamingBulkReleaseTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+
+	UObject* Owner = NewObject<UObject>(GetTransientPackage());
+	Owner->AddToRoot();
+
+	// A group of requests sharing an asset, and requests of an owner.
+	FAssetStreamingRequestHandle Handles[5];
+	Subsystem->RequestAssetStreaming(Assets, nullptr, Handles[0], EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, TEXT("Level")));
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, Handles[1], EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, TEXT("Level")));
+	Subsystem->RequestAssetStreaming(Assets[1], nullptr, Handles[2], EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(Owner));
+	Subsystem->RequestAssetStreaming(Assets[2], nullptr, Handles[3], EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(Owner));
+	Subsystem->RequestAssetStreaming(Assets[2], nullptr, Handles[4]);
+
+	TestEqual(TEXT("Group requests are released together"), Subsystem->ReleaseGroup(TEXT("Level")), 2);
+	TestEqual(TEXT("Shared asset is unreferenced once"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 1u);
+	TestFalse(TEXT("Handles of released requests are stale"), Subsystem->ReleaseAssets(Handles[1]));
+
+	TestEqual(TEXT("Owner requests are released together"), Subsystem->ReleaseAllForOwner(Owner), 2);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Only the asset of the untagged request is left"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 1);
+
+	// Requests whose owner is destroyed are released by the sweep following the garbage collection.
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, Handles[0], EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(Owner));
+	Owner->RemoveFromRoot();
+	Owner->MarkPendingKill();
+
+	FAssetStreamingTestAccess::SimulatePostGarbageCollect(*Subsystem);
+	TestEqual(TEXT("Request of the destroyed owner is released"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[0]), 0);
+	TestEqual(TEXT("Request without owner is kept"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Assets[2]), 1);
+
+	Subsystem->ReleaseAssets(Handles[4]);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingReclaimTest, "SimpleAssetStreaming.Subsystem.Reclaim", AssetStreamingTestFlags)
+
+bool FAssetStreamingReclaimTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+	FAssetStreamingTestAccess::SetReclaimThreshold(*Subsystem, 1000);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	FAssetStreamingRequestHandle Handles[2];
+	for (int32 Index = 0; Index < 2; Index++)
+	{
+		Subsystem->RequestAssetStreaming(Assets[Index], nullptr, Handles[Index]);
+		FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Assets[Index], 600);
+	}
+
+	// A single unload stays below the threshold.
+	Subsystem->ReleaseAssets(Handles[0]);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Unloaded asset awaits the garbage collection"), FAssetStreamingTestAccess::GetUnreachableBytes(*Subsystem), static_cast<int64>(600));
+	TestEqual(TEXT("No collection is requested below the threshold"), FAssetStreamingTestAccess::GetNumReclaims(*Subsystem), 0u);
+
+	Subsystem->ReleaseAssets(Handles[1]);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("A collection is requested above the threshold"), FAssetStreamingTestAccess::GetNumReclaims(*Subsystem), 1u);
+
+	FAssetStreamingTestAccess::SimulatePostGarbageCollect(*Subsystem);
+	TestEqual(TEXT("Collection reclaims the unloaded assets"), FAssetStreamingTestAccess::GetUnreachableBytes(*Subsystem), static_cast<int64>(0));
+
+	// An asset whose batch still keeps another asset alive stays in memory, it isn't awaiting the collection.
+	FAssetStreamingRequestHandle BatchHandle;
+	FAssetStreamingRequestHandle SingleHandle;
+	Subsystem->RequestAssetBatchStreaming(Assets, nullptr, BatchHandle);
+	Subsystem->RequestAssetStreaming(Assets[0], nullptr, SingleHandle);
+	for (const TSoftObjectPtr<UObject>& Asset : Assets)
+	{
+		FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Asset, 600);
+	}
+
+	Subsystem->ReleaseAssets(BatchHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset held by its batch isn't awaiting the collection"), FAssetStreamingTestAccess::GetUnreachableBytes(*Subsystem), static_cast<int64>(0));
+
+	Subsystem->ReleaseAssets(SingleHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Last asset of the batch awaits the collection"), FAssetStreamingTestAccess::GetUnreachableBytes(*Subsystem), static_cast<int64>(600));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingSortedSubmissionTest, "SimpleAssetStreaming.Subsystem.SortedLoadSubmission", AssetStreamingTestFlags)
+
+bool FAssetStreamingSortedSubmissionTest::RunTest(const FString& Parameters)
+{
+	// Without pak files or chunks, packages are sorted by name.
+	FAssetStreamingLoadOrder LoadOrder;
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Add(FSoftObjectPath(TEXT("/Game/Sorted/B/Second.Second")));
+	AssetPaths.Add(FSoftObjectPath(TEXT("/Game/Sorted/A/First.First")));
+	LoadOrder.Sort(AssetPaths);
+	TestEqual(TEXT("Packages are sorted by name"), AssetPaths[0], FSoftObjectPath(TEXT("/Game/Sorted/A/First.First")));
+
+	TSoftObjectPtr<UObject> Asset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(Asset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping."));
+		return true;
+	}
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+	FAssetStreamingTestAccess::SetSortLoadSubmissions(*Subsystem, true);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Request is accepted"), Subsystem->RequestAssetStreaming(Asset, nullptr, RequestHandle));
+	TestEqual(TEXT("Load waits for the submission window"), FAssetStreamingTestAccess::GetNumPendingLoads(*Subsystem), 1);
+	TestEqual(TEXT("Nothing is loading yet"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 0u);
+
+	// A request released before the window closes never loads anything.
+	FAssetStreamingRequestHandle ReleasedHandle;
+	Subsystem->RequestAssetStreaming(Asset, nullptr, ReleasedHandle);
+	Subsystem->ReleaseAssets(ReleasedHandle);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Loads are submitted by the next tick"), FAssetStreamingTestAccess::GetNumPendingLoads(*Subsystem), 0);
+	TestEqual(TEXT("Asset load is in flight"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 1u);
+	TestEqual(TEXT("Only the active request references the asset"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Asset), 1);
+
+	FlushAsyncLoading();
+	TestTrue(TEXT("Asset is loaded"), Asset.IsValid());
+
+	Subsystem->ReleaseAssets(RequestHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, TArray<UObject*>()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingClassFilterTest, "SimpleAssetStreaming.Subsystem.ClassFilter", AssetStreamingTestFlags)
+
+bool FAssetStreamingClassFilterTest::RunTest(const FString& Parameters)
+{
+	TSoftObjectPtr<UObject> Asset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(Asset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping."));
+		return true;
+	}
+
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	if (!AssetRegistry.GetAssetByObjectPath(Asset.ToSoftObjectPath().GetAssetPathName()).IsValid())
+	{
+		AddWarning(TEXT("The asset registry doesn't know the engine assets yet, skipping."));
+		return true;
+	}
+
+	// The candidate engine assets are all static meshes. Tests run outside of any world, in standalone mode.
+	FAssetStreamingClassFilter Filter;
+	Filter.NetMode = TEXT("Standalone");
+	Filter.ExcludedClasses.Add(TEXT("StaticMesh"));
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetClassFilters(*Subsystem, { Filter });
+
+	TArray<TSoftObjectPtr<UObject>> Assets;
+	Assets.Add(Asset);
+
+	int32 NumCompletions = 0;
+	TArray<UObject*> CompletedObjects;
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Request for an excluded asset is accepted"), Subsystem->RequestAssetStreaming(Assets, RequestHandle, [&NumCompletions, &CompletedObjects](const TArray<UObject*>& LoadedObjects)
+	{
+		NumCompletions++;
+		CompletedObjects = LoadedObjects;
+	}));
+
+	FAssetStreamingRequestHandle SingleHandle;
+	TestTrue(TEXT("Single request for an excluded asset is accepted"), Subsystem->RequestAssetStreaming(Asset, nullptr, SingleHandle));
+
+	TestEqual(TEXT("Excluded asset isn't loaded"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 0u);
+	TestEqual(TEXT("Excluded asset isn't tracked"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Request completes by the next pump"), NumCompletions, 1);
+	TestTrue(TEXT("Excluded asset is completed without an object"), CompletedObjects.Num() == 1 && CompletedObjects[0] == nullptr);
+
+	TestTrue(TEXT("Request is released as usual"), Subsystem->ReleaseAssets(RequestHandle));
+	TestTrue(TEXT("Single request is released as usual"), Subsystem->ReleaseAssets(SingleHandle));
+	TestFalse(TEXT("Asset was never loaded"), Asset.IsValid());
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, TArray<UObject*>()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingClassPolicyTest, "SimpleAssetStreaming.Subsystem.ClassPolicy", AssetStreamingTestFlags)
+
+bool FAssetStreamingClassPolicyTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 60.0f);
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+
+	// The first asset is reclaimed right away, the others are kept in the warm cache of the transient package's policy.
+	FAssetStreamingClassPolicy HeavyPolicy;
+	HeavyPolicy.PathPrefix = Assets[0].ToSoftObjectPath().ToString();
+	HeavyPolicy.UnloadDelaySeconds = 0.0f;
+
+	FAssetStreamingClassPolicy CheapPolicy;
+	CheapPolicy.PathPrefix = GetTransientPackage()->GetPathName();
+	CheapPolicy.MaxWarmCacheBytes = 1024 * 1024;
+	CheapPolicy.bUnloadUnderMemoryPressure = false;
+
+	FAssetStreamingClassPolicy InvalidPolicy;
+	FAssetStreamingTestAccess::SetClassPolicies(*Subsystem, { HeavyPolicy, CheapPolicy, InvalidPolicy });
+
+	FAssetStreamingRequestHandle RequestHandle;
+	TestTrue(TEXT("Request succeeds"), Subsystem->RequestAssetStreaming(Assets, nullptr, RequestHandle));
+	TestTrue(TEXT("Release succeeds"), Subsystem->ReleaseAssets(RequestHandle));
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestNull(TEXT("Asset of the heavy policy is unloaded without waiting for the subsystem's delay"), FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[0]));
+
+	for (int32 Index = 1; Index < Assets.Num(); Index++)
+	{
+		const FAssetStreamingRecord* Record = FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[Index]);
+		TestTrue(TEXT("Asset of the cheap policy is kept in its warm cache"), Record && Record->State == EAssetRecordState::Cached);
+	}
+
+	// Requesting a cached asset again takes it back from the warm cache of its policy.
+	TestTrue(TEXT("Request of a cached asset succeeds"), Subsystem->RequestAssetStreaming(Assets[1], nullptr, RequestHandle));
+	const FAssetStreamingRecord* Record = FAssetStreamingTestAccess::FindRecord(*Subsystem, Assets[1]);
+	TestTrue(TEXT("Cached asset is referenced again"), Record && Record->State == EAssetRecordState::Referenced && Record->CacheSlot == INDEX_NONE);
+	Subsystem->ReleaseAssets(RequestHandle);
+
+	// Trims flush every warm cache, whatever the policy. The pump unloads the evicted assets within its budget.
+	FAssetStreamingTestAccess::SimulateMemoryTrim(*Subsystem);
+	TestEqual(TEXT("Evicted assets wait for the pump"), FAssetStreamingTestAccess::GetNumPendingUnloads(*Subsystem), 2u);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Warm caches are flushed"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingWaitForRequestsTest, "SimpleAssetStreaming.Subsystem.WaitForRequests", AssetStreamingTestFlags)
+
+bool FAssetStreamingWaitForRequestsTest::RunTest(const FString& Parameters)
+{
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(2, Objects);
+
+	// In-memory assets are resident as soon as they're requested.
+	FAssetStreamingRequestHandle ResidentHandle;
+	Subsystem->RequestAssetStreaming(Assets, nullptr, ResidentHandle);
+	TestEqual(TEXT("Resident request is fully loaded"), Subsystem->GetRequestProgress(ResidentHandle), 1.0f);
+
+	TFuture<bool> ResidentFuture = Subsystem->WaitForRequests({ ResidentHandle }, 1.0f);
+	TestTrue(TEXT("Waiting on a resident request completes right away"), ResidentFuture.IsReady() && ResidentFuture.Get());
+
+	// Releasing a request before it completes fails the wait.
+	FAssetStreamingRequestHandle ReleasedHandle = ResidentHandle;
+	Subsystem->ReleaseAssets(ResidentHandle);
+	TestEqual(TEXT("Released request has no progress"), Subsystem->GetRequestProgress(ReleasedHandle), 0.0f);
+
+	TFuture<bool> ReleasedFuture = Subsystem->WaitForRequests({ ReleasedHandle }, 0.0f);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Waiting on a released request fails"), ReleasedFuture.IsReady() && !ReleasedFuture.Get());
+
+	TSoftObjectPtr<UObject> DiskAsset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(DiskAsset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping the blocking wait."));
+		ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+		return true;
+	}
+
+	FAssetStreamingRequestHandle DiskHandle;
+	Subsystem->RequestAssetStreaming(DiskAsset, nullptr, DiskHandle, EAssetStreamingPriority::Background);
+	TFuture<bool> DiskFuture = Subsystem->WaitForRequests({ DiskHandle }, 30.0f);
+
+	TestTrue(TEXT("Blocking wait completes the load"), Subsystem->WaitForRequestsBlocking({ DiskHandle }, 30.0f));
+	TestTrue(TEXT("Asset is resident after the blocking wait"), DiskAsset.IsValid());
+	TestEqual(TEXT("Request is fully loaded"), Subsystem->GetRequestProgress(DiskHandle), 1.0f);
+
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestTrue(TEXT("Waiting future completes on the next tick"), DiskFuture.IsReady() && DiskFuture.Get());
+
+	Subsystem->ReleaseAssets(DiskHandle);
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingStaleRequestsTest, "SimpleAssetStreaming.Subsystem.StaleRequests", AssetStreamingTestFlags)
+
+bool FAssetStreamingStaleRequestsTest::RunTest(const FString& Parameters)
+{
+	static const FName LeakyCallsite(TEXT("LeakyCallsite"));
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+
+	TArray<UObject*> Objects;
+	const TArray<TSoftObjectPtr<UObject>> Assets = FAssetStreamingTestAccess::CreateSyntheticAssets(3, Objects);
+
+	// The first request's owner is destroyed without releasing it. The second one shares an asset with it.
+	UObject* Owner = NewObject<UObject>(GetTransientPackage());
+
+	const TArray<TSoftObjectPtr<UObject>> OwnedAssets = { Assets[0], Assets[1] };
+	FAssetStreamingRequestHandle OwnedHandle;
+	Subsystem->RequestAssetStreaming(OwnedAssets, nullptr, OwnedHandle, EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(Owner));
+
+	const TArray<TSoftObjectPtr<UObject>> LeakedAssets = { Assets[1], Assets[2] };
+	FAssetStreamingRequestHandle LeakedHandle;
+	Subsystem->RequestAssetStreaming(LeakedAssets, nullptr, LeakedHandle, EAssetStreamingPriority::Normal, FAssetStreamingRequestOptions(nullptr, NAME_None, LeakyCallsite));
+
+	for (const TSoftObjectPtr<UObject>& Asset : Assets)
+	{
+		FAssetStreamingTestAccess::SetResidentBytes(*Subsystem, Asset, 1000);
+	}
+
+	Owner->MarkPendingKill();
+
+	TArray<FAssetStreamingStaleRequests> StaleRequests;
+	TestEqual(TEXT("Requests of destroyed owners are stale whatever their age"), Subsystem->FindStaleRequests(1.0e6f, StaleRequests), 1);
+	if (StaleRequests.Num() == 1)
+	{
+		TestTrue(TEXT("Owner is reported as destroyed"), StaleRequests[0].bOwnerDestroyed);
+		TestEqual(TEXT("Both assets of the request are referenced"), StaleRequests[0].ResidentBytes, 2000ll);
+		TestEqual(TEXT("Only the asset nothing else references is pinned"), StaleRequests[0].PinnedBytes, 1000ll);
+	}
+
+	TestEqual(TEXT("Every request is older than zero seconds"), Subsystem->FindStaleRequests(0.0f, StaleRequests), 2);
+	const FAssetStreamingStaleRequests* Leaked = StaleRequests.FindByPredicate([](const FAssetStreamingStaleRequests& Group) { return Group.Callsite == LeakyCallsite; });
+	TestTrue(TEXT("Request is reported by callsite"), Leaked && Leaked->NumRequests == 1 && !Leaked->bOwnerDestroyed);
+	TestTrue(TEXT("Assets shared between stale groups aren't pinned by either"), Leaked && Leaked->PinnedBytes == 1000);
+
+	Subsystem->ReleaseAssets(OwnedHandle);
+	Subsystem->ReleaseAssets(LeakedHandle);
+	TestEqual(TEXT("Released requests aren't stale"), Subsystem->FindStaleRequests(0.0f, StaleRequests), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, Objects));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingDependencyExpansionTest, "SimpleAssetStreaming.Subsystem.DependencyExpansion", AssetStreamingTestFlags)
+
+bool FAssetStreamingDependencyExpansionTest::RunTest(const FString& Parameters)
+{
+	TSoftObjectPtr<UObject> Asset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(Asset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping."));
+		return true;
+	}
+
+	FAssetStreamingDependencies Dependencies;
+	const TArray<FSoftObjectPath> AssetDependencies = Dependencies.Expand(Asset.ToSoftObjectPath(), 512);
+	if (AssetDependencies.Num() == 0)
+	{
+		AddWarning(TEXT("The asset registry doesn't know the dependencies of the engine assets yet, skipping."));
+		return true;
+	}
+
+	TestEqual(TEXT("Expansion is cached per root package"), Dependencies.Num(), 1);
+	TestEqual(TEXT("Cached expansion is returned again"), Dependencies.Expand(Asset.ToSoftObjectPath(), 512).Num(), AssetDependencies.Num());
+	TestTrue(TEXT("Expansion is capped, even once a larger one is cached"), Dependencies.Expand(Asset.ToSoftObjectPath(), 1).Num() <= 1);
+	TestEqual(TEXT("Expansions are cached per cap"), Dependencies.Num(), 2);
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+	FAssetStreamingTestAccess::SetExpandDependencies(*Subsystem, true);
+
+	TArray<TSoftObjectPtr<UObject>> Assets;
+	Assets.Add(Asset);
+
+	// Two requests sharing the asset share its dependencies too, each referencing them once.
+	FAssetStreamingRequestHandle FirstHandle;
+	FAssetStreamingRequestHandle SecondHandle;
+	TestTrue(TEXT("First request is accepted"), Subsystem->RequestAssetStreaming(Assets, nullptr, FirstHandle));
+	TestTrue(TEXT("Second request is accepted"), Subsystem->RequestAssetBatchStreaming(Assets, nullptr, SecondHandle));
+
+	const TSoftObjectPtr<UObject> Dependency(AssetDependencies[0]);
+	TestEqual(TEXT("Tracked assets include the dependencies"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), AssetDependencies.Num() + 1);
+	TestEqual(TEXT("Requested asset is referenced by both requests"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Asset), 2);
+	TestEqual(TEXT("Dependency is referenced once per request"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Dependency), 2);
+
+	// The dependencies stay alive as long as any request references them.
+	Subsystem->ReleaseAssets(FirstHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Dependency is kept by the second request"), FAssetStreamingTestAccess::GetRequestCount(*Subsystem, Dependency), 1);
+
+	Subsystem->ReleaseAssets(SecondHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Dependencies are unloaded with the last request"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	FlushAsyncLoading();
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, TArray<UObject*>()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingLoadFromDiskTest, "SimpleAssetStreaming.Subsystem.LoadFromDisk", AssetStreamingTestFlags)
+
+bool FAssetStreamingLoadFromDiskTest::RunTest(const FString& Parameters)
+{
+	TSoftObjectPtr<UObject> Asset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(Asset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping."));
+		return true;
+	}
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	Subsystem->RequestAssetStreaming(Asset, nullptr, RequestHandle);
+	TestEqual(TEXT("Asset load is in flight"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 1u);
+
+	// A second request attaches to the pending load instead of starting another one.
+	FAssetStreamingRequestHandle SecondHandle;
+	Subsystem->RequestAssetStreaming(Asset, nullptr, SecondHandle);
+	TestEqual(TEXT("Second request doesn't start another load"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 1u);
+	TestTrue(TEXT("Both requests share the loading handle"), FAssetStreamingTestAccess::GetAssetHandle(*Subsystem, RequestHandle, 0) == FAssetStreamingTestAccess::GetAssetHandle(*Subsystem, SecondHandle, 0));
+
+	FlushAsyncLoading();
+	TestTrue(TEXT("Asset is loaded"), Asset.IsValid());
+	TestEqual(TEXT("Asset load completed"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 0u);
+	TestEqual(TEXT("Load latency was measured for both requests"), Subsystem->GetLatencyHistogram().GetNumSamples(), 2u);
+
+	Subsystem->ReleaseAssets(RequestHandle);
+	Subsystem->ReleaseAssets(SecondHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, TArray<UObject*>()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingReleaseBeforeLoadTest, "SimpleAssetStreaming.Subsystem.ReleaseBeforeLoadCompletes", AssetStreamingTestFlags)
+
+bool FAssetStreamingReleaseBeforeLoadTest::RunTest(const FString& Parameters)
+{
+	TSoftObjectPtr<UObject> Asset;
+	if (!FAssetStreamingTestAccess::FindUnloadedEngineAsset(Asset))
+	{
+		AddWarning(TEXT("Every candidate engine asset is already loaded, skipping."));
+		return true;
+	}
+
+	UAssetStreamingSubsystem* Subsystem = FAssetStreamingTestAccess::CreateSubsystem();
+	FAssetStreamingTestAccess::SetUnloadDelay(*Subsystem, 0.0f);
+
+	FAssetStreamingRequestHandle RequestHandle;
+	Subsystem->RequestAssetStreaming(Asset, nullptr, RequestHandle);
+	TestEqual(TEXT("Asset load is in flight"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 1u);
+
+	// Release and unload the asset before the async loader gets to it.
+	Subsystem->ReleaseAssets(RequestHandle);
+	FAssetStreamingTestAccess::Tick(*Subsystem);
+	TestEqual(TEXT("Asset is unloaded"), FAssetStreamingTestAccess::GetNumTrackedAssets(*Subsystem), 0);
+	TestEqual(TEXT("Cancelled load isn't in flight anymore"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 0u);
+
+	// The package may still finish loading, but the cancelled handle must never call back.
+	FlushAsyncLoading();
+	TestEqual(TEXT("Cancelled load never called back"), Subsystem->GetLatencyHistogram().GetNumSamples(), 0u);
+	TestEqual(TEXT("In-flight loads didn't go below zero"), FAssetStreamingTestAccess::GetNumInFlightLoads(*Subsystem), 0u);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FAssetStreamingCleanupCommand(Subsystem, TArray<UObject*>()));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingStartupManifestTest, "SimpleAssetStreaming.StartupManifest.RoundTrip", AssetStreamingTestFlags)
+
+bool FAssetStreamingStartupManifestTest::RunTest(const FString& Parameters)
+{
+	const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("AssetStreamingManifest"), TEXT(".bin"));
+
+	TArray<FSoftObjectPath> AssetPaths;
+	AssetPaths.Add(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")));
+	AssetPaths.Add(FSoftObjectPath(TEXT("/Engine/BasicShapes/Sphere.Sphere")));
+
+	TArray<FSoftObjectPath> LoadedPaths;
+	TestTrue(TEXT("Manifest is saved"), FAssetStreamingStartupManifest::Save(Filename, AssetPaths));
+	TestTrue(TEXT("Manifest is loaded"), FAssetStreamingStartupManifest::Load(Filename, LoadedPaths));
+	TestEqual(TEXT("Paths are loaded in request order"), LoadedPaths, AssetPaths);
+
+	// Files that aren't manifests are ignored.
+	AddExpectedError(TEXT("Ignoring invalid startup manifest"), EAutomationExpectedErrorFlags::Contains, 1);
+	FFileHelper::SaveStringToFile(TEXT("Not a manifest"), *Filename);
+	TestFalse(TEXT("Invalid manifest isn't loaded"), FAssetStreamingStartupManifest::Load(Filename, LoadedPaths));
+	TestEqual(TEXT("Invalid manifest has no paths"), LoadedPaths.Num(), 0);
+
+	IFileManager::Get().Delete(*Filename);
+	TestFalse(TEXT("Missing manifest isn't loaded"), FAssetStreamingStartupManifest::Load(Filename, LoadedPaths));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingPredictorTest, "SimpleAssetStreaming.Predictor.CoOccurrence", AssetStreamingTestFlags)
+
+bool FAssetStreamingPredictorTest::RunTest(const FString& Parameters)
+{
+	const FSoftObjectPath First(TEXT("/Game/Predictor/First.First"));
+	const FSoftObjectPath Second(TEXT("/Game/Predictor/Second.Second"));
+	const FSoftObjectPath Unrelated(TEXT("/Game/Predictor/Unrelated.Unrelated"));
+
+	FAssetStreamingPredictor Predictor;
+	Predictor.Initialize(64, 1.0f);
+
+	// The second asset always follows the first one within the window, the unrelated one never does.
+	TArray<FSoftObjectPath> Predictions;
+	double Now = 0.0;
+	for (int32 Round = 0; Round < 3; Round++)
+	{
+		Predictor.Observe(First, Now, 0.5f, Predictions);
+		Predictor.Observe(Second, Now + 0.1, 0.5f, Predictions);
+		Predictor.Observe(Unrelated, Now + 1.5, 0.5f, Predictions);
+		Now += 2.0;
+	}
+
+	Predictions.Reset();
+	Predictor.Observe(First, Now, 0.5f, Predictions);
+	TestTrue(TEXT("Second asset is predicted from the first one"), Predictions.Contains(Second));
+	TestFalse(TEXT("Assets outside of the window aren't predicted"), Predictions.Contains(Unrelated));
+
+	Predictions.Reset();
+	Predictor.Observe(First, Now + 0.5, 1.1f, Predictions);
+	TestEqual(TEXT("Nothing is predicted above the observed confidence"), Predictions.Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAssetStreamingTraceReplayTest, "SimpleAssetStreaming.Trace.RoundTripReplay", AssetStreamingTestFlags)
+
+bool FAssetStreamingTraceReplayTest::RunTest(const FString& Parameters)
+{
+	const FSoftObjectPath First(TEXT("/Game/Trace/First.First"));
+	const FSoftObjectPath Second(TEXT("/Game/Trace/Second.Second"));
+	static constexpr int64 Megabyte = 1024 * 1024;
+
+	// The first asset is released, then requested again two seconds later. The second one is requested once, after that.
+	FAssetStreamingTrace Recorded;
+	Recorded.Reset(100.0);
+	Recorded.RecordRequest(100.0, 0, First);
+	Recorded.RecordLoaded(100.5, First, Megabyte);
+	Recorded.RecordRelease(101.0, 0);
+	Recorded.RecordRequest(103.0, 0, First);
+	Recorded.RecordRelease(103.1, 0);
+	Recorded.RecordRequest(104.0, 1, Second);
+	Recorded.RecordLoaded(104.1, Second, 2 * Megabyte);
+	Recorded.RecordRelease(105.0, 1);
+	Recorded.RecordUnloaded(106.0, First);
+
+	const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("AssetStreamingTrace"), TEXT(".bin"));
+	FAssetStreamingTrace Trace;
+	TestTrue(TEXT("Trace is saved"), Recorded.Save(Filename));
+	TestTrue(TEXT("Trace is loaded"), Trace.Load(Filename));
+	TestEqual(TEXT("Asset paths are loaded"), Trace.GetAssetPaths(), Recorded.GetAssetPaths());
+
+	if (TestEqual(TEXT("Every event is loaded"), Trace.Num(), Recorded.Num()))
+	{
+		for (int32 Index = 0; Index < Trace.Num(); Index++)
+		{
+			const FAssetStreamingTraceEntry& Expected = Recorded.GetEntries()[Index];
+			const FAssetStreamingTraceEntry& Actual = Trace.GetEntries()[Index];
+			TestTrue(TEXT("Event is loaded as recorded"), Actual.Type == Expected.Type && Actual.RequestId == Expected.RequestId && Actual.AssetIndex == Expected.AssetIndex && Actual.SizeBytes == Expected.SizeBytes);
+			TestEqual(TEXT("Event time is relative to the start of the trace"), Actual.Time, Expected.Time, 1.0e-6);
+		}
+	}
+
+	// Files that aren't traces are ignored.
+	AddExpectedError(TEXT("Ignoring invalid asset streaming trace"), EAutomationExpectedErrorFlags::Contains, 1);
+	FFileHelper::SaveStringToFile(TEXT("Not a trace"), *Filename);
+	FAssetStreamingTrace Invalid;
+	TestFalse(TEXT("Invalid trace isn't loaded"), Invalid.Load(Filename));
+	TestEqual(TEXT("Invalid trace has no events"), Invalid.Num(), 0);
+	IFileManager::Get().Delete(*Filename);
+
+	// Loads take 10 ms whatever the size of the assets.
+	FAssetStreamingReplayLatency Latency;
+	Latency.BaseMs = 10.0f;
+	Latency.MegabytesPerSecond = 0.0f;
+
+	const FAssetStreamingReplayResult NoDelay = FAssetStreamingTraceReplay::Run(Trace, FAssetStreamingReplayPolicy(0.0f, 0), Latency);
+	TestEqual(TEXT("Every requested asset is counted"), NoDelay.NumRequestedAssets, 3u);
+	TestEqual(TEXT("Without delay, the first asset is loaded again"), NoDelay.NumReloads, 1u);
+	TestEqual(TEXT("Without delay, nothing is a hit"), NoDelay.NumHits, 0u);
+	TestEqual(TEXT("Every request waits for its load"), NoDelay.GetAverageWaitMs(), 10.0f, 0.01f);
+	TestEqual(TEXT("Without delay, the assets are never loaded together"), NoDelay.PeakTrackedBytes, 2 * Megabyte);
+
+	const FAssetStreamingReplayResult LongDelay = FAssetStreamingTraceReplay::Run(Trace, FAssetStreamingReplayPolicy(5.0f, 0), Latency);
+	TestEqual(TEXT("With a delay, the first asset is still loaded when requested again"), LongDelay.NumHits, 1u);
+	TestEqual(TEXT("With a delay, nothing is reloaded"), LongDelay.NumReloads, 0u);
+	TestEqual(TEXT("With a delay, the assets are loaded together"), LongDelay.PeakTrackedBytes, 3 * Megabyte);
+
+	const FAssetStreamingReplayResult Cached = FAssetStreamingTraceReplay::Run(Trace, FAssetStreamingReplayPolicy(0.0f, Megabyte), Latency);
+	TestEqual(TEXT("The warm cache keeps the first asset"), Cached.NumHits, 1u);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistryModule.h"
+#include "AssetStreamingSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Access to the internals of the subsystem, so that tests don't depend on the game instance, the ticker or real time.
+ */
+class FAssetStreamingTestAccess
+{
+public:
+
+	// Creates a subsystem outside of any game instance. Tick it manually with Tick().
+	static UAssetStreamingSubsystem* CreateSubsystem()
+	{
+		UAssetStreamingSubsystem* Subsystem = NewObject<UAssetStreamingSubsystem>(GetTransientPackage());
+		Subsystem->AddToRoot();
+		return Subsystem;
+	}
+
+	static void SetUnloadDelay(UAssetStreamingSubsystem& Subsystem, const float UnloadDelaySeconds) { Subsystem.UnloadDelaySeconds = UnloadDelaySeconds; }
+
+	static void SetPumpBudget(UAssetStreamingSubsystem& Subsystem, const float PumpBudgetMs) { Subsystem.PumpBudgetMs = PumpBudgetMs; }
+
+	static void SetProximityEvaluationsPerTick(UAssetStreamingSubsystem& Subsystem, const int32 NumEvaluations) { Subsystem.ProximityEvaluationsPerTick = NumEvaluations; }
+
+	static void SetMemoryWatermarks(UAssetStreamingSubsystem& Subsystem, const TArray<int64>& Watermarks) { Subsystem.MemoryWatermarksBytes = Watermarks; }
+
+	static void Tick(UAssetStreamingSubsystem& Subsystem) { Subsystem.Tick(0.0f); }
+
+	static void SetSortLoadSubmissions(UAssetStreamingSubsystem& Subsystem, const bool bSortLoadSubmissions) { Subsystem.bSortLoadSubmissions = bSortLoadSubmissions; }
+
+	static int32 GetNumPendingLoads(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.PendingLoads.Num(); }
+
+	static int32 GetNumQueuedRequestHandles(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.QueuedRequestHandles.Num(); }
+
+	static void SetExpandDependencies(UAssetStreamingSubsystem& Subsystem, const bool bExpandDependencies) { Subsystem.bExpandDependencies = bExpandDependencies; }
+
+	// Sets the class filters, and the asset registry they need, as Initialize() would.
+	static void SetClassFilters(UAssetStreamingSubsystem& Subsystem, const TArray<FAssetStreamingClassFilter>& ClassFilters)
+	{
+		Subsystem.ClassFilters = ClassFilters;
+		Subsystem.AssetRegistry = &FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	}
+
+	// Sets the class policies and their warm caches, as Initialize() would.
+	static void SetClassPolicies(UAssetStreamingSubsystem& Subsystem, const TArray<FAssetStreamingClassPolicy>& ClassPolicies)
+	{
+		Subsystem.ClassPolicies = ClassPolicies;
+		Subsystem.InitializeClassPolicies();
+	}
+
+	static void SetReclaimThreshold(UAssetStreamingSubsystem& Subsystem, const int64 ReclaimThresholdBytes) { Subsystem.ReclaimThresholdBytes = ReclaimThresholdBytes; }
+
+	static int64 GetUnreachableBytes(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.UnreachableBytes; }
+
+	static uint32 GetNumReclaims(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.NumReclaims; }
+
+	// Runs what the subsystem does after garbage collections, without collecting anything.
+	static void SimulatePostGarbageCollect(UAssetStreamingSubsystem& Subsystem) { Subsystem.HandlePostGarbageCollect(); }
+
+	// Runs what the subsystem does when the platform asks to trim memory.
+	static void SimulateMemoryTrim(UAssetStreamingSubsystem& Subsystem) { Subsystem.HandleMemoryTrim(); }
+
+	// Overrides the measured size of an asset. In-memory test objects don't report any size of their own.
+	static void SetResidentBytes(UAssetStreamingSubsystem& Subsystem, const TSoftObjectPtr<UObject>& Asset, const int64 ResidentBytes)
+	{
+		Subsystem.SetResidentBytes(Subsystem.RecordIndices.FindChecked(Asset.ToSoftObjectPath()), ResidentBytes);
+	}
+
+	static int32 GetNumTrackedAssets(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.Records.Num(); }
+
+	static uint32 GetNumInFlightLoads(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.NumInFlightLoads; }
+
+	static uint32 GetNumPendingUnloads(const UAssetStreamingSubsystem& Subsystem) { return Subsystem.NumPendingUnloads; }
+
+	// Returns the streamable handle a request holds for one of its assets.
+	static TSharedPtr<FStreamableHandle> GetAssetHandle(UAssetStreamingSubsystem& Subsystem, const FAssetStreamingRequestHandle& RequestHandle, const int32 AssetIndex)
+	{
+		const FAssetStreamingRequest* Request = Subsystem.FindRequest(RequestHandle);
+		return Request && Request->Assets.IsValidIndex(AssetIndex) ? Request->Assets[AssetIndex].Handle : nullptr;
+	}
+
+	// Returns the record of an asset, or null if the subsystem doesn't track it.
+	static const FAssetStreamingRecord* FindRecord(const UAssetStreamingSubsystem& Subsystem, const TSoftObjectPtr<UObject>& Asset)
+	{
+		const int32* RecordIndex = Subsystem.RecordIndices.Find(Asset.ToSoftObjectPath());
+		return RecordIndex ? &Subsystem.Records[*RecordIndex] : nullptr;
+	}
+
+	// Returns the number of requests referencing an asset, zero if the subsystem doesn't track it.
+	static int32 GetRequestCount(const UAssetStreamingSubsystem& Subsystem, const TSoftObjectPtr<UObject>& Asset)
+	{
+		const FAssetStreamingRecord* Record = FindRecord(Subsystem, Asset);
+		return Record ? Record->RequestCount : 0;
+	}
+
+	/**
+	 * Creates in-memory objects standing in for assets. They are already loaded, so streaming them never hits the disk.
+	 * @param Num The number of objects to create.
+	 * @param OutObjects The created objects, rooted until DestroySyntheticAssets() is called.
+	 * @returns Soft pointers to the created objects.
+	 */
+	static TArray<TSoftObjectPtr<UObject>> CreateSyntheticAssets(const int32 Num, TArray<UObject*>& OutObjects)
+	{
+		TArray<TSoftObjectPtr<UObject>> Assets;
+		Assets.Reserve(Num);
+		OutObjects.Reserve(Num);
+
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			const FName Name = MakeUniqueObjectName(GetTransientPackage(), UObject::StaticClass(), TEXT("AssetStreamingTestAsset"));
+			UObject* Object = NewObject<UObject>(GetTransientPackage(), Name);
+			Object->AddToRoot();
+
+			OutObjects.Add(Object);
+			Assets.Add(TSoftObjectPtr<UObject>(Object));
+		}
+
+		return Assets;
+	}
+
+	static void DestroySyntheticAssets(TArray<UObject*>& Objects)
+	{
+		for (UObject* Object : Objects)
+		{
+			Object->RemoveFromRoot();
+		}
+
+		Objects.Reset();
+	}
+
+	/**
+	 * Finds an engine asset that exists on disk but isn't loaded yet.
+	 * @param OutAsset The asset that was found.
+	 * @returns False if every candidate is already loaded, in which case tests that need a real load should be skipped.
+	 */
+	static bool FindUnloadedEngineAsset(TSoftObjectPtr<UObject>& OutAsset)
+	{
+		static const TCHAR* Candidates[] =
+		{
+			TEXT("/Engine/BasicShapes/Cone.Cone"),
+			TEXT("/Engine/BasicShapes/Cylinder.Cylinder"),
+			TEXT("/Engine/BasicShapes/Plane.Plane"),
+			TEXT("/Engine/BasicShapes/Sphere.Sphere"),
+			TEXT("/Engine/BasicShapes/Cube.Cube"),
+		};
+
+		for (const TCHAR* Candidate : Candidates)
+		{
+			const FSoftObjectPath Path(Candidate);
+			if (!Path.ResolveObject() && FPackageName::DoesPackageExist(Path.GetLongPackageName()))
+			{
+				OutAsset = TSoftObjectPtr<UObject>(Path);
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+/**
+ * Releases a subsystem and the synthetic assets created by a test.
+ * Waits a frame first: the streamable manager delays the callbacks of assets that were already loaded.
+ */
+class FAssetStreamingCleanupCommand : public IAutomationLatentCommand
+{
+public:
+
+	FAssetStreamingCleanupCommand(UAssetStreamingSubsystem* InSubsystem, const TArray<UObject*>& InObjects)
+		: Subsystem(InSubsystem)
+		, Objects(InObjects)
+		, bHasWaitedFrame(false)
+	{}
+
+	virtual bool Update() override
+	{
+		if (!bHasWaitedFrame)
+		{
+			bHasWaitedFrame = true;
+			return false;
+		}
+
+		Subsystem->RemoveFromRoot();
+		FAssetStreamingTestAccess::DestroySyntheticAssets(Objects);
+
+		return true;
+	}
+
+private:
+
+	UAssetStreamingSubsystem* Subsystem;
+
+	TArray<UObject*> Objects;
+
+	bool bHasWaitedFrame;
+};
+
+#endif
@@ -40,11 +40,13 @@ public:
 	FAssetHandlePair()
 		: Asset(nullptr)
 		, Handle(nullptr)
+		, RecordIndex(INDEX_NONE)
 	{}
 
-	FAssetHandlePair(const TSoftObjectPtr<UObject>& InAsset, const TSharedPtr<FStreamableHandle>& InHandle)
+	FAssetHandlePair(const TSoftObjectPtr<UObject>& InAsset, const TSharedPtr<FStreamableHandle>& InHandle, const int32 InRecordIndex = INDEX_NONE)
 		: Asset(InAsset)
 		, Handle(InHandle)
+		, RecordIndex(InRecordIndex)
 	{}
 
 	FORCEINLINE bool operator==(const FAssetHandlePair& RHS) const
@@ -55,4 +57,7 @@ public:
 	TSoftObjectPtr<UObject> Asset;
 
 	TSharedPtr<FStreamableHandle> Handle;
+
+	// Index of the asset's record in the asset streaming subsystem.
+	int32 RecordIndex;
 };
\ No newline at end of file
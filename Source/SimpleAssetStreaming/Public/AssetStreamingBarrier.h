@@ -0,0 +1,52 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingRequestHandle.h"
+#include "Async/Future.h"
+
+/**
+ * Something waiting for a set of requests to finish loading, i.e. a loading screen.
+ * Resolved with true once nothing of the requests is loading anymore, or with false at the deadline or when one of the requests is released first.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingBarrier
+{
+	FAssetStreamingBarrier(const TArray<FAssetStreamingRequestHandle>& InRequestHandles, const double InDeadline)
+		: RequestHandles(InRequestHandles)
+		, Deadline(InDeadline)
+		, Promise(MakeShared<TPromise<bool>, ESPMode::ThreadSafe>())
+	{}
+
+	// The requests waited on, resolved to their slot if they were queued from another thread.
+	TArray<FAssetStreamingRequestHandle> RequestHandles;
+
+	double Deadline;
+
+	// Shared so that barriers can be moved around, promises can't be copied.
+	TSharedRef<TPromise<bool>, ESPMode::ThreadSafe> Promise;
+};
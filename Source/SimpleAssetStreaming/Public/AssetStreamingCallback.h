@@ -45,6 +45,7 @@ class UAssetStreamingCallback : public UInterface
 /**
  * Interface used to receive callbacks when an asset is loaded by the asset streaming subsystem.
  * Callbacks will be called each time a requested asset is loaded, or directly if it was already loaded.
+ * Batch requests will additionally call OnAssetBatchLoaded once the whole batch is done loading.
  */
 class SIMPLEASSETSTREAMING_API IAssetStreamingCallback
 {
@@ -55,4 +56,8 @@ public:
 	UFUNCTION(BlueprintNativeEvent, DisplayName = "On Asset Loaded")
 	void OnAssetLoaded(const TSoftObjectPtr<UObject>& LoadedAsset, const bool bWasAlreadyLoaded);
 	virtual void OnAssetLoaded_Implementation(const TSoftObjectPtr<UObject>& LoadedAsset, const bool bWasAlreadyLoaded);
+
+	UFUNCTION(BlueprintNativeEvent, DisplayName = "On Asset Batch Loaded")
+	void OnAssetBatchLoaded(const TArray<TSoftObjectPtr<UObject>>& LoadedAssets);
+	virtual void OnAssetBatchLoaded_Implementation(const TArray<TSoftObjectPtr<UObject>>& LoadedAssets);
 };
\ No newline at end of file
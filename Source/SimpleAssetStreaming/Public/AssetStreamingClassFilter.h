@@ -0,0 +1,53 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingClassFilter.generated.h"
+
+/**
+ * Asset classes that aren't loaded in a given net mode, i.e. textures and sounds on dedicated servers.
+ * Requests for them complete right away without loading anything.
+ */
+USTRUCT()
+struct SIMPLEASSETSTREAMING_API FAssetStreamingClassFilter
+{
+	GENERATED_BODY()
+
+	FAssetStreamingClassFilter()
+		: NetMode(NAME_None)
+		, ExcludedClasses()
+	{}
+
+	// The net mode the filter applies to: Standalone, DedicatedServer, ListenServer or Client.
+	UPROPERTY()
+	FName NetMode;
+
+	// The short names of the excluded classes, i.e. Texture or SoundBase. Their subclasses are excluded too.
+	UPROPERTY()
+	TArray<FName> ExcludedClasses;
+};
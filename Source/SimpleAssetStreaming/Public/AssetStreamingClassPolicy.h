@@ -0,0 +1,74 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingPriority.h"
+#include "AssetStreamingClassPolicy.generated.h"
+
+/**
+ * Retention and unload settings for the assets of a class or under a path, overriding the subsystem-wide ones.
+ * Lets cheap, frequently reused assets stay resident while heavy ones are reclaimed quickly.
+ */
+USTRUCT()
+struct SIMPLEASSETSTREAMING_API FAssetStreamingClassPolicy
+{
+	GENERATED_BODY()
+
+	FAssetStreamingClassPolicy()
+		: AssetClass(NAME_None)
+		, PathPrefix()
+		, UnloadDelaySeconds(5.0f)
+		, MaxWarmCacheBytes(0)
+		, bUnloadUnderMemoryPressure(true)
+		, DefaultPriority(EAssetStreamingPriority::Normal)
+	{}
+
+	// The short name of the class the policy applies to, i.e. SoundCue. Subclasses match too. None matches every class.
+	UPROPERTY()
+	FName AssetClass;
+
+	// The start of the object paths the policy applies to, i.e. /Game/Landscape/. Empty matches every path.
+	UPROPERTY()
+	FString PathPrefix;
+
+	// The delay before released assets are unloaded, when they aren't kept in the warm cache.
+	UPROPERTY()
+	float UnloadDelaySeconds;
+
+	// The maximum size of the released assets of the policy kept in their own warm cache. Zero disables it.
+	UPROPERTY()
+	int64 MaxWarmCacheBytes;
+
+	// Whether released assets are unloaded right away, and evicted from the warm cache, when memory runs low.
+	UPROPERTY()
+	bool bUnloadUnderMemoryPressure;
+
+	// The priority assets are loaded at when they're requested at Normal priority.
+	UPROPERTY()
+	EAssetStreamingPriority DefaultPriority;
+};
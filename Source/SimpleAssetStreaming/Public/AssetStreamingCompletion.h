@@ -0,0 +1,80 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingRecord.h"
+
+struct FAssetStreamingBatch;
+
+/**
+ * A loaded callback waiting to be dispatched by the subsystem's pump.
+ * Either a single asset request, an asset of a batch, or a whole batch.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingCompletion
+{
+	explicit FAssetStreamingCompletion(const FAssetLoadWaiter& InWaiter)
+		: Waiter(InWaiter)
+		, Batch()
+		, AssetIndex(INDEX_NONE)
+	{}
+
+	FAssetStreamingCompletion(const TSharedRef<FAssetStreamingBatch>& InBatch, const int32 InAssetIndex)
+		: Waiter()
+		, Batch(InBatch)
+		, AssetIndex(InAssetIndex)
+	{}
+
+	// The request to call back, if this isn't a batch.
+	FAssetLoadWaiter Waiter;
+
+	TSharedPtr<FAssetStreamingBatch> Batch;
+
+	// The asset of the batch to call back, INDEX_NONE once the whole batch is loaded.
+	int32 AssetIndex;
+};
+
+/**
+ * How far behind the subsystem's pump is, after its last tick.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingPumpBacklog
+{
+	FAssetStreamingPumpBacklog()
+		: NumCompletions(0)
+		, NumUnloads(0)
+		, NumFramesBehind(0)
+	{}
+
+	// The loaded callbacks carried over to the next frame.
+	int32 NumCompletions;
+
+	// The expired unloads carried over to the next frame. May include unloads that were cancelled since.
+	int32 NumUnloads;
+
+	// The number of consecutive ticks the pump ran out of budget.
+	uint32 NumFramesBehind;
+};
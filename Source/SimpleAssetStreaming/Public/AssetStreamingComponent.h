@@ -0,0 +1,98 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingPriority.h"
+#include "Components/ActorComponent.h"
+#include "AssetStreamingComponent.generated.h"
+
+class UAssetStreamingSubsystem;
+
+/**
+ * Streams a set of assets while a view is close to the owning actor, and releases them once every view went away.
+ * Components don't tick: the asset streaming subsystem evaluates all of them using a spatial hash, spread over multiple frames.
+ */
+UCLASS(ClassGroup = (AssetStreaming), meta = (BlueprintSpawnableComponent))
+class SIMPLEASSETSTREAMING_API UAssetStreamingComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+
+    UAssetStreamingComponent();
+
+    // The assets to stream while a view is within the enter radius.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming")
+    TArray<TSoftObjectPtr<UObject>> Assets;
+
+    // The assets are requested once a view gets closer than this distance.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming", meta = (ClampMin = "0.0"))
+    float EnterRadius;
+
+    // The assets are released once every view is further than this distance. Kept above the enter radius so that assets don't thrash at the boundary.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming", meta = (ClampMin = "0.0"))
+    float ExitRadius;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming")
+    EAssetStreamingPriority Priority;
+
+    // Whether to request the assets as a single batch.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming")
+    bool bStreamAsBatch;
+
+    // Offset from the owner's location distances are measured from, i.e. to stream the interior of a building from its entrance.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming")
+    FVector StreamingOffset;
+
+    // Whether the owner moves. Movable components are evaluated every cycle, static ones only when a view is close to them.
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asset Streaming")
+    bool bIsMovable;
+
+    virtual void BeginPlay() override;
+
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    // Returns whether the subsystem currently streams the assets of this component.
+    UFUNCTION(BlueprintPure, Category = "Asset Streaming")
+    FORCEINLINE bool IsStreamingAssets() const { return bIsStreamingAssets; }
+
+    // Returns the location distances to the views are measured from.
+    FVector GetStreamingLocation() const;
+
+private:
+
+    friend class UAssetStreamingSubsystem;
+
+    // The subsystem the component is registered to.
+    TWeakObjectPtr<UAssetStreamingSubsystem> StreamingSubsystem;
+
+    // The index of the component's entry in the subsystem, INDEX_NONE while it isn't registered.
+    int32 ProximityIndex;
+
+    bool bIsStreamingAssets;
+};
@@ -0,0 +1,66 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Resolves and caches the assets a requested asset hard depends on, from the asset registry's dependency data.
+ * The loader brings hard dependencies along with the asset anyway. Tracking them lets requests share and account for them explicitly.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingDependencies
+{
+public:
+
+	FAssetStreamingDependencies()
+		: Expansions()
+	{}
+
+	/**
+	 * Returns the assets of the packages an asset's package hard depends on, directly or not. Walked on the first request for the package and cap, then cached.
+	 * Script packages and packages the asset registry doesn't know about are skipped.
+	 * @param AssetPath The requested asset.
+	 * @param MaxDependencies The maximum number of dependencies to return, the closest ones first.
+	 * @returns The dependencies of the asset. Only valid until the next call.
+	 */
+	const TArray<FSoftObjectPath>& Expand(const FSoftObjectPath& AssetPath, const int32 MaxDependencies);
+
+	// Returns the number of cached expansions.
+	FORCEINLINE int32 Num() const { return Expansions.Num(); }
+
+	// Returns the memory allocated by the cached expansions.
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	// The dependencies of each package walked so far, by package and maximum number of dependencies.
+	TMap<TPair<FName, int32>, TArray<FSoftObjectPath>> Expansions;
+
+	// The cache is dropped once it holds this many packages, rather than growing without bounds.
+	static constexpr int32 MaxCachedExpansions = 4096;
+};
@@ -0,0 +1,85 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Histogram of the time between an asset request and its loaded callback.
+ * Buckets double in size, starting from one millisecond. The last bucket holds everything slower.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingLatencyHistogram
+{
+public:
+
+	static constexpr int32 NumBuckets = 14;
+
+	FAssetStreamingLatencyHistogram()
+	{
+		Reset();
+	}
+
+	/**
+	 * Add a latency sample to the histogram.
+	 * @param LatencySeconds The time between the request and the callback, in seconds.
+	 */
+	void Add(const double LatencySeconds);
+
+	// Removes every sample.
+	void Reset();
+
+	/**
+	 * Estimate a percentile of the latency, from the upper bound of the bucket that contains it.
+	 * @param Percentile The percentile to estimate, between 0 and 1.
+	 * @returns The estimated latency in milliseconds. Zero if there are no samples.
+	 */
+	double GetPercentileMs(const double Percentile) const;
+
+	// Returns the exclusive upper bound of a bucket, in milliseconds. The last bucket has no upper bound.
+	FORCEINLINE static double GetBucketUpperBoundMs(const int32 Bucket) { return static_cast<double>(1 << Bucket); }
+
+	FORCEINLINE uint32 GetBucketCount(const int32 Bucket) const { return Buckets[Bucket]; }
+
+	FORCEINLINE uint32 GetNumSamples() const { return NumSamples; }
+
+	FORCEINLINE double GetAverageMs() const { return NumSamples > 0 ? TotalMs / NumSamples : 0.0; }
+
+	FORCEINLINE double GetMaxMs() const { return MaxMs; }
+
+	// Returns a single line summary of the histogram, used for logging.
+	FString ToString() const;
+
+private:
+
+	uint32 Buckets[NumBuckets];
+
+	uint32 NumSamples;
+
+	double TotalMs;
+
+	double MaxMs;
+};
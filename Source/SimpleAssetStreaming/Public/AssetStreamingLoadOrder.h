@@ -0,0 +1,141 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingPriority.h"
+#include "AssetStreamingRequestHandle.h"
+#include "UObject/ScriptInterface.h"
+#include "UObject/SoftObjectPtr.h"
+
+class FPakPlatformFile;
+class IAssetStreamingCallback;
+
+/**
+ * Where the package of an asset lives on disk, used to submit loads in the order they can be read.
+ * Packages are sorted by chunk, then by offset in their pak file, then by name. Whatever isn't known sorts last in its group.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingLoadOrderKey
+{
+	FAssetStreamingLoadOrderKey()
+		: ChunkId(MAX_int32)
+		, Offset(MAX_int64)
+		, PackageName(NAME_None)
+	{}
+
+	// The first chunk the package was cooked to, as listed by the asset registry. Each chunk is usually its own pak file.
+	int32 ChunkId;
+
+	// The offset of the package in its pak file.
+	int64 Offset;
+
+	FName PackageName;
+
+	FORCEINLINE bool operator<(const FAssetStreamingLoadOrderKey& Other) const
+	{
+		if (ChunkId != Other.ChunkId) return ChunkId < Other.ChunkId;
+		if (Offset != Other.Offset) return Offset < Other.Offset;
+		return PackageName.LexicalLess(Other.PackageName);
+	}
+};
+
+/**
+ * A new load waiting for the submission window to close, see UAssetStreamingSubsystem::bSortLoadSubmissions.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingPendingLoad
+{
+	FAssetStreamingPendingLoad()
+		: Asset()
+		, Callback()
+		, RequestHandle()
+		, Priority(EAssetStreamingPriority::Normal)
+		, OrderKey()
+	{}
+
+	FAssetStreamingPendingLoad(const TSoftObjectPtr<UObject>& InAsset, const TScriptInterface<IAssetStreamingCallback>& InCallback, const FAssetStreamingRequestHandle& InRequestHandle)
+		: Asset(InAsset)
+		, Callback(InCallback)
+		, RequestHandle(InRequestHandle)
+		, Priority(EAssetStreamingPriority::Normal)
+		, OrderKey()
+	{}
+
+	TSoftObjectPtr<UObject> Asset;
+
+	TScriptInterface<IAssetStreamingCallback> Callback;
+
+	// The load is dropped if this request is released before it is submitted.
+	FAssetStreamingRequestHandle RequestHandle;
+
+	// The priority of the request when the load is submitted, it may have been raised in the meantime.
+	EAssetStreamingPriority Priority;
+
+	FAssetStreamingLoadOrderKey OrderKey;
+};
+
+/**
+ * Resolves and caches where the packages of assets live on disk, from the asset registry and the mounted pak files.
+ * Outside of cooked builds running from pak files, assets are only sorted by package name.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingLoadOrder
+{
+public:
+
+	FAssetStreamingLoadOrder()
+		: Keys()
+		, PakPlatformFile(nullptr)
+		, bHasFoundPakPlatformFile(false)
+	{}
+
+	/**
+	 * Returns where the package of an asset lives on disk. Resolved on the first request for the package, then cached.
+	 * @param AssetPath The asset to locate.
+	 * @returns The key the asset's load is sorted with.
+	 */
+	FAssetStreamingLoadOrderKey GetKey(const FSoftObjectPath& AssetPath);
+
+	/**
+	 * Sort assets in the order their packages can be read.
+	 * @param AssetPaths The assets to sort.
+	 */
+	void Sort(TArray<FSoftObjectPath>& AssetPaths);
+
+	// Returns the memory allocated by the cached keys.
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Keys.GetAllocatedSize(); }
+
+private:
+
+	// The cache is dropped once it holds this many packages, so that it can't grow without bounds.
+	static constexpr int32 MaxCachedKeys = 65536;
+
+	TMap<FName, FAssetStreamingLoadOrderKey> Keys;
+
+	// The pak platform file, if the game runs from pak files.
+	FPakPlatformFile* PakPlatformFile;
+
+	bool bHasFoundPakPlatformFile;
+};
@@ -0,0 +1,61 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingOwnerMemory.generated.h"
+
+/**
+ * The memory held by the requests of an owner or tag, as reported by the memory queries of the subsystem.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEASSETSTREAMING_API FAssetStreamingOwnerMemory
+{
+	GENERATED_BODY()
+
+	FAssetStreamingOwnerMemory()
+		: Owner(NAME_None)
+		, ResidentBytes(0)
+		, NumRequests(0)
+		, NumAssets(0)
+	{}
+
+	// The tag of the requests, or the class of their owner if they have no tag.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	FName Owner;
+
+	// The size of the assets referenced by the requests. Assets shared with other owners count toward each of them.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int64 ResidentBytes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int32 NumRequests;
+
+	// The number of distinct assets referenced by the requests.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int32 NumAssets;
+};
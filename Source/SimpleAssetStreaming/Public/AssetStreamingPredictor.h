@@ -0,0 +1,156 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+/**
+ * Learns which assets are requested shortly after each other, and predicts the ones likely to follow a request.
+ * Requests are remembered over a sliding window: every request counts as a successor of the recent requests before it.
+ * Statistics live in a direct-mapped table allocated once, so memory stays fixed however many assets are requested.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingPredictor
+{
+public:
+
+	FAssetStreamingPredictor()
+		: Table()
+		, TableMask(0)
+		, NextWindowSlot(0)
+		, WindowSeconds(1.0f)
+	{
+		FMemory::Memzero(Window);
+	}
+
+	/**
+	 * Allocate the statistics table.
+	 * @param NumEntries The number of assets the table holds statistics for, rounded up to a power of two.
+	 * @param InWindowSeconds How long after a request other requests count as its successors.
+	 */
+	void Initialize(const int32 NumEntries, const float InWindowSeconds);
+
+	FORCEINLINE bool IsInitialized() const { return Table.Num() > 0; }
+
+	/**
+	 * Learn from a request, then predict the assets likely to be requested next.
+	 * @param AssetPath The requested asset.
+	 * @param Now The time of the request.
+	 * @param MinConfidence The share of the asset's requests a successor must have followed to be predicted.
+	 * @param OutPredictions The array the predicted assets are appended to.
+	 */
+	void Observe(const FSoftObjectPath& AssetPath, const double Now, const float MinConfidence, TArray<FSoftObjectPath>& OutPredictions);
+
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Table.GetAllocatedSize(); }
+
+private:
+
+	static constexpr int32 NumSuccessors = 4;
+
+	static constexpr int32 WindowSize = 8;
+
+	// Assets requested less often than this aren't predicted from, their statistics are too noisy.
+	static constexpr uint16 MinOccurrences = 3;
+
+	struct FSuccessor
+	{
+		FSoftObjectPath Path;
+		uint32 PathHash;
+
+		// How many times the successor followed the asset.
+		uint16 Count;
+	};
+
+	struct FEntry
+	{
+		// The hash of the asset the statistics are for, zero if the entry is empty. Colliding assets replace each other.
+		uint32 PathHash;
+
+		// How many times the asset was requested.
+		uint16 Occurrences;
+
+		FSuccessor Successors[NumSuccessors];
+	};
+
+	struct FWindowEntry
+	{
+		uint32 PathHash;
+		double Time;
+	};
+
+	// Counts a successor of an entry, replacing its least frequent successor if every slot is taken.
+	static void AddSuccessor(FEntry& Entry, const FSoftObjectPath& Path, const uint32 PathHash);
+
+	TArray<FEntry> Table;
+
+	uint32 TableMask;
+
+	// Ring buffer of the latest requests.
+	FWindowEntry Window[WindowSize];
+
+	int32 NextWindowSlot;
+
+	float WindowSeconds;
+};
+
+/**
+ * A speculative load of a predicted asset. Holds no reference on the asset's record: it is dropped once a request adopts the asset or the prefetch expires.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingPrefetch
+{
+	TSharedPtr<FStreamableHandle> Handle;
+
+	// When the prefetch is dropped if no request adopted it.
+	double ExpireTime;
+};
+
+/**
+ * How useful the predictive prefetches were, used to tune the predictor.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingPrefetchStats
+{
+	FAssetStreamingPrefetchStats()
+		: NumIssued(0)
+		, NumHits(0)
+		, NumWasted(0)
+		, WastedBytes(0)
+	{}
+
+	// Returns the share of the resolved prefetches that a request adopted, between 0 and 1.
+	FORCEINLINE float GetAccuracy() const { return NumHits + NumWasted > 0 ? static_cast<float>(NumHits) / (NumHits + NumWasted) : 0.0f; }
+
+	uint32 NumIssued;
+
+	// Prefetches adopted by a request.
+	uint32 NumHits;
+
+	// Prefetches that expired without being requested.
+	uint32 NumWasted;
+
+	// The size of the assets of the wasted prefetches.
+	int64 WastedBytes;
+};
@@ -0,0 +1,50 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingPriority.generated.h"
+
+/**
+ * Priority classes used to order asset streaming requests.
+ * Higher priorities are loaded before lower ones by the async loader.
+ */
+UENUM(BlueprintType)
+enum class EAssetStreamingPriority : uint8
+{
+	// Assets that aren't needed right away, i.e. prefetching or distant actors.
+	Background	UMETA(DisplayName = "Background"),
+
+	// Default priority, same as the engine's default async load priority.
+	Normal		UMETA(DisplayName = "Normal"),
+
+	// Assets the player can currently see, i.e. UI icons or nearby meshes.
+	Visible		UMETA(DisplayName = "Visible"),
+
+	// Assets that block gameplay until they're loaded.
+	Critical	UMETA(DisplayName = "Critical")
+};
@@ -0,0 +1,61 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingRequestHandle.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UAssetStreamingComponent;
+
+/**
+ * A streaming component registered to the subsystem, evaluated against the view locations.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingProximityEntry
+{
+	FAssetStreamingProximityEntry(UAssetStreamingComponent* InComponent, const FVector& InLocation, const FIntPoint& InCell)
+		: Component(InComponent)
+		, Location(InLocation)
+		, Cell(InCell)
+		, RequestHandle()
+		, LastCycle(0)
+	{}
+
+	TWeakObjectPtr<UAssetStreamingComponent> Component;
+
+	// The location of the component when it was last evaluated. Only refreshed for movable components.
+	FVector Location;
+
+	// The cell of the spatial hash the entry is in.
+	FIntPoint Cell;
+
+	// The request streaming the component's assets, invalid while they aren't streamed.
+	FAssetStreamingRequestHandle RequestHandle;
+
+	// The last evaluation cycle the entry was gathered in, so that it's only evaluated once per cycle.
+	uint32 LastCycle;
+};
@@ -0,0 +1,72 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingPriority.h"
+#include "AssetStreamingRequestHandle.h"
+#include "AssetStreamingRequestOptions.h"
+#include "UObject/ScriptInterface.h"
+#include "UObject/SoftObjectPtr.h"
+
+class IAssetStreamingCallback;
+
+enum class EAssetStreamingOperation : uint8
+{
+	Request,
+	BatchRequest,
+	Release
+};
+
+/**
+ * A request or release queued by another thread, submitted on the game thread during the next tick.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingQueuedOperation
+{
+	FAssetStreamingQueuedOperation()
+		: Operation(EAssetStreamingOperation::Request)
+		, RequestHandle()
+		, Assets()
+		, Callback()
+		, Priority(EAssetStreamingPriority::Normal)
+		, Options()
+	{}
+
+	EAssetStreamingOperation Operation;
+
+	// The queued handle of a request, or the handle to release.
+	FAssetStreamingRequestHandle RequestHandle;
+
+	// The assets to stream. Empty for releases.
+	TArray<TSoftObjectPtr<UObject>> Assets;
+
+	TScriptInterface<IAssetStreamingCallback> Callback;
+
+	EAssetStreamingPriority Priority;
+
+	FAssetStreamingRequestOptions Options;
+};
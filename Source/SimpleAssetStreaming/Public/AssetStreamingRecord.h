@@ -0,0 +1,136 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingRequestHandle.h"
+#include "Engine/StreamableManager.h"
+#include "UObject/ScriptInterface.h"
+#include "UObject/SoftObjectPtr.h"
+
+class IAssetStreamingCallback;
+
+/**
+ * Lifecycle state of a tracked asset.
+ */
+enum class EAssetRecordState : uint8
+{
+	// The asset is referenced by at least one request.
+	Referenced,
+
+	// Nothing references the asset anymore, it is waiting in the unload queue.
+	PendingUnload,
+
+	// Nothing references the asset anymore, it is kept in the warm cache.
+	Cached
+};
+
+/**
+ * A request waiting to be called back once an asset is loaded.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetLoadWaiter
+{
+	FAssetLoadWaiter()
+		: Asset()
+		, Callback()
+		, RequestHandle()
+		, RequestTime(0.0)
+		, bWasAlreadyLoaded(false)
+		, bIsExcluded(false)
+	{}
+
+	FAssetLoadWaiter(const TSoftObjectPtr<UObject>& InAsset, const TScriptInterface<IAssetStreamingCallback>& InCallback, const FAssetStreamingRequestHandle& InRequestHandle, const double InRequestTime, const bool bInWasAlreadyLoaded, const bool bInIsExcluded = false)
+		: Asset(InAsset)
+		, Callback(InCallback)
+		, RequestHandle(InRequestHandle)
+		, RequestTime(InRequestTime)
+		, bWasAlreadyLoaded(bInWasAlreadyLoaded)
+		, bIsExcluded(bInIsExcluded)
+	{}
+
+	TSoftObjectPtr<UObject> Asset;
+
+	TScriptInterface<IAssetStreamingCallback> Callback;
+
+	// The waiter is skipped if this request is released before the asset is loaded.
+	FAssetStreamingRequestHandle RequestHandle;
+
+	// When the asset was requested, used to measure the load latency.
+	double RequestTime;
+
+	bool bWasAlreadyLoaded;
+
+	// Whether the class of the asset is excluded in the current net mode. The callback is called without loading it.
+	bool bIsExcluded;
+};
+
+/**
+ * Everything the subsystem knows about a tracked asset.
+ * Looked up once by path when an asset is requested, then referenced by index.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingRecord
+{
+	explicit FAssetStreamingRecord(const FSoftObjectPath& InAssetPath)
+		: AssetPath(InAssetPath)
+		, KeepAlive(nullptr)
+		, RequestCount(0)
+		, State(EAssetRecordState::Referenced)
+		, UnloadSerial(0)
+		, CacheSlot(INDEX_NONE)
+		, ResidentBytes(0)
+		, PolicyIndex(INDEX_NONE)
+	{}
+
+	FAssetStreamingRecord()
+		: FAssetStreamingRecord(FSoftObjectPath())
+	{}
+
+	FSoftObjectPath AssetPath;
+
+	// Handle kept alive until we finally unload the asset.
+	TSharedPtr<FStreamableHandle> KeepAlive;
+
+	// The number of requests referencing the asset.
+	int32 RequestCount;
+
+	EAssetRecordState State;
+
+	// Serial of the asset's entry in the unload queue, zero if it isn't pending unload.
+	uint32 UnloadSerial;
+
+	// Slot of the asset in the warm cache, INDEX_NONE if it isn't cached.
+	int32 CacheSlot;
+
+	// The size of the asset in memory, measured once it is loaded. Zero until then.
+	int64 ResidentBytes;
+
+	// Index of the class policy the asset follows, INDEX_NONE if it follows the subsystem's settings.
+	int32 PolicyIndex;
+
+	// Requests to call back once the pending load of the asset completes.
+	TArray<FAssetLoadWaiter> Waiters;
+};
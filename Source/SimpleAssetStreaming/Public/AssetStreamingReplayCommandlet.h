@@ -0,0 +1,53 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AssetStreamingReplayCommandlet.generated.h"
+
+/**
+ * Replays an asset streaming trace with every combination of the given policies, and reports what each would have cost.
+ * Doesn't load any asset, so it runs headless, i.e. "UE4Editor-Cmd MyGame -run=AssetStreamingReplay -Trace=Trace.bin -UnloadDelays=0,5,30 -CacheBudgetsMB=0,256".
+ * Other parameters: -LatencyMs=10 for the fixed cost of a load, -BandwidthMBps=50 for the read speed used with the measured size of the assets.
+ */
+UCLASS()
+class UAssetStreamingReplayCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+
+    UAssetStreamingReplayCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+
+private:
+
+    // Parses a comma separated list of numbers, falling back to the default values if the parameter is missing.
+    static TArray<float> ParseValues(const FString& Params, const TCHAR* Name, const TArray<float>& DefaultValues);
+};
@@ -0,0 +1,79 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetHandlePair.h"
+#include "AssetStreamingPriority.h"
+#include "AssetStreamingRequestHandle.h"
+#include "UObject/WeakObjectPtr.h"
+
+// Most requests stream a handful of assets, keep them inline to avoid allocating.
+typedef TArray<FAssetHandlePair, TInlineAllocator<4>> FAssetHandleArray;
+
+/**
+ * Bookkeeping of a single streaming request, stored in a reusable slot of the subsystem.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingRequest
+{
+	FAssetStreamingRequest()
+		: Assets()
+		, Priority(EAssetStreamingPriority::Normal)
+		, Owner(nullptr)
+		, Tag(NAME_None)
+		, Callsite(NAME_None)
+		, RequestTime(0.0)
+		, QueuedHandle()
+		, Generation(1)
+		, bIsActive(false)
+	{}
+
+	// The requested assets and their handle.
+	FAssetHandleArray Assets;
+
+	// The priority the assets are currently streamed at.
+	EAssetStreamingPriority Priority;
+
+	// Who the request belongs to, see FAssetStreamingRequestOptions.
+	TWeakObjectPtr<UObject> Owner;
+
+	FName Tag;
+
+	FName Callsite;
+
+	// When the request was made, used to find requests that were never released.
+	double RequestTime;
+
+	// The handle returned to the thread that queued the request, if it was queued. Forgotten along with the slot.
+	FAssetStreamingRequestHandle QueuedHandle;
+
+	// The generation of the slot. Bumped every time the request is released.
+	uint32 Generation;
+
+	// Whether the slot currently holds a request.
+	bool bIsActive;
+};
@@ -0,0 +1,84 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/Guid.h"
+
+/**
+ * Lightweight handle to a streaming request: the index of the request slot in the subsystem and the generation of that slot.
+ * Releasing a request bumps the generation of its slot, making every handle to it stale even once the slot is reused.
+ */
+struct SIMPLEASSETSTREAMING_API FAssetStreamingRequestHandle
+{
+	FAssetStreamingRequestHandle()
+		: Index(0)
+		, Generation(0)
+	{}
+
+	FAssetStreamingRequestHandle(const uint32 InIndex, const uint32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{}
+
+	// Generation zero is never assigned to a request.
+	FORCEINLINE bool IsValid() const { return Generation != 0; }
+
+	// Returns true if the handle was returned by a request queued from another thread, rather than pointing to a request slot.
+	FORCEINLINE bool IsQueued() const { return (Generation & QueuedGenerationBit) != 0; }
+
+	FORCEINLINE void Invalidate() { *this = FAssetStreamingRequestHandle(); }
+
+	FORCEINLINE bool operator==(const FAssetStreamingRequestHandle& RHS) const { return Index == RHS.Index && Generation == RHS.Generation; }
+
+	FORCEINLINE bool operator!=(const FAssetStreamingRequestHandle& RHS) const { return !(*this == RHS); }
+
+	FORCEINLINE friend uint32 GetTypeHash(const FAssetStreamingRequestHandle& Handle) { return HashCombine(Handle.Index, Handle.Generation); }
+
+	// Converts the handle to the request guid used by the Blueprint API. Invalid handles give an invalid guid.
+	FORCEINLINE FGuid ToGuid() const { return IsValid() ? FGuid(Index, Generation, GuidMarker, GuidMarker) : FGuid(); }
+
+	// Converts a request guid back to a handle. Guids that weren't created from a handle give an invalid handle.
+	FORCEINLINE static FAssetStreamingRequestHandle FromGuid(const FGuid& Guid)
+	{
+		return Guid.C == GuidMarker && Guid.D == GuidMarker ? FAssetStreamingRequestHandle(Guid.A, Guid.B) : FAssetStreamingRequestHandle();
+	}
+
+	FORCEINLINE FString ToString() const { return FString::Printf(TEXT("%u:%u"), Index, Generation); }
+
+	uint32 Index;
+
+	uint32 Generation;
+
+	// Set in the generation of queued handles, whose index is a sequence number. Request slots never reach this generation.
+	static constexpr uint32 QueuedGenerationBit = 0x80000000;
+
+private:
+
+	// Stored in the last two components of request guids, so that random guids aren't mistaken for handles.
+	static constexpr uint32 GuidMarker = 0x41535248;
+};
@@ -0,0 +1,67 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "AssetStreamingRequestOptions.generated.h"
+
+// The function making a request, for the Callsite of its options. Stale request audits report requests by callsite.
+#define ASSET_STREAMING_CALLSITE FName(__FUNCTION__)
+
+/**
+ * Optional information attached to a request, used to find out who is holding streamed assets.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEASSETSTREAMING_API FAssetStreamingRequestOptions
+{
+	GENERATED_BODY()
+
+	FAssetStreamingRequestOptions()
+		: Owner(nullptr)
+		, Tag(NAME_None)
+		, Callsite(NAME_None)
+	{}
+
+	explicit FAssetStreamingRequestOptions(UObject* InOwner, const FName InTag = NAME_None, const FName InCallsite = NAME_None)
+		: Owner(InOwner)
+		, Tag(InTag)
+		, Callsite(InCallsite)
+	{}
+
+	// The object the request belongs to. Memory is reported by the owner's class unless a tag is set.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Streaming")
+	TWeakObjectPtr<UObject> Owner;
+
+	// The system the request belongs to, i.e. "Weapons" or "UI". Memory is reported by tag when it is set.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Streaming")
+	FName Tag;
+
+	// Where the request is made, i.e. ASSET_STREAMING_CALLSITE. Only used to find the requests that were never released.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Asset Streaming")
+	FName Callsite;
+};
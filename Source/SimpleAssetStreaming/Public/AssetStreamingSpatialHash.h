@@ -0,0 +1,78 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid bucketing ids by the cell their location falls in, used to find what is close to a point without visiting everything.
+ * The grid is two dimensional: heights are ignored when bucketing, open worlds spread along the ground.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingSpatialHash
+{
+public:
+
+	FAssetStreamingSpatialHash()
+		: Cells()
+		, CellSize(10000.0f)
+		, NumIds(0)
+	{}
+
+	// Sets the size of the cells. Can only be changed while the grid is empty.
+	void SetCellSize(const float InCellSize);
+
+	// Returns the cell a location falls in.
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void Add(const int32 Id, const FIntPoint& Cell);
+
+	// Removes an id from the cell it was added to.
+	void Remove(const int32 Id, const FIntPoint& Cell);
+
+	/**
+	 * Collects the ids of every cell overlapping a sphere. Ids may be further away than the radius, the caller checks the actual distance.
+	 * @param Center The center of the sphere.
+	 * @param Radius The radius of the sphere.
+	 * @param OutIds The array the ids are appended to.
+	 */
+	void Query(const FVector& Center, const float Radius, TArray<int32>& OutIds) const;
+
+	FORCEINLINE int32 Num() const { return NumIds; }
+
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+
+	// Ids in each occupied cell. Empty cells are removed.
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	float CellSize;
+
+	int32 NumIds;
+};
@@ -0,0 +1,75 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetStreamingStaleRequests.generated.h"
+
+/**
+ * Requests that were never released, grouped by owner and callsite, as reported by the stale request audits of the subsystem.
+ */
+USTRUCT(BlueprintType)
+struct SIMPLEASSETSTREAMING_API FAssetStreamingStaleRequests
+{
+	GENERATED_BODY()
+
+	FAssetStreamingStaleRequests()
+		: Owner(NAME_None)
+		, Callsite(NAME_None)
+		, bOwnerDestroyed(false)
+		, NumRequests(0)
+		, OldestAgeSeconds(0.0f)
+		, ResidentBytes(0)
+		, PinnedBytes(0)
+	{}
+
+	// The tag of the requests, or the class of their owner if they have no tag. See FAssetStreamingOwnerMemory.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	FName Owner;
+
+	// Where the requests were made, None if they didn't say.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	FName Callsite;
+
+	// Whether the owner of the requests was garbage collected. Their requests are stale whatever their age.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	bool bOwnerDestroyed;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int32 NumRequests;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	float OldestAgeSeconds;
+
+	// The size of the assets referenced by the requests.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int64 ResidentBytes;
+
+	// The size of the assets nothing else references, which releasing the requests would unload.
+	UPROPERTY(BlueprintReadOnly, Category = "Asset Streaming")
+	int64 PinnedBytes;
+};
@@ -0,0 +1,63 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Binary list of the asset paths requested early in a session, in request order.
+ * Recorded by the subsystem during a session and preloaded at the start of the next one.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingStartupManifest
+{
+public:
+
+	// Returns where the subsystem records and reads the manifest.
+	static FString GetDefaultFilename();
+
+	/**
+	 * Write a manifest to disk, replacing any previous one.
+	 * @param Filename The file to write.
+	 * @param AssetPaths The requested asset paths, in request order.
+	 * @returns True if the file was written.
+	 */
+	static bool Save(const FString& Filename, const TArray<FSoftObjectPath>& AssetPaths);
+
+	/**
+	 * Read a manifest from disk.
+	 * @param Filename The file to read.
+	 * @param OutAssetPaths The recorded asset paths, in request order. Empty if the file is missing or invalid.
+	 * @returns True if the file was read.
+	 */
+	static bool Load(const FString& Filename, TArray<FSoftObjectPath>& OutAssetPaths);
+
+private:
+
+	static constexpr uint32 Magic = 0x464D5341; // "ASMF"
+
+	static constexpr uint32 Version = 1;
+};
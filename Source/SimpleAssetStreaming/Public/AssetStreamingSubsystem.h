@@ -28,19 +28,56 @@ SOFTWARE.
 
 #include "CoreMinimal.h"
 #include "AssetHandlePair.h"
+#include "AssetStreamingBarrier.h"
+#include "AssetStreamingClassFilter.h"
+#include "AssetStreamingClassPolicy.h"
+#include "AssetStreamingCompletion.h"
+#include "AssetStreamingLatencyHistogram.h"
+#include "AssetStreamingLoadOrder.h"
+#include "AssetStreamingDependencies.h"
+#include "AssetStreamingOwnerMemory.h"
+#include "AssetStreamingPredictor.h"
+#include "AssetStreamingPriority.h"
+#include "AssetStreamingProximityEntry.h"
+#include "AssetStreamingQueuedOperation.h"
+#include "AssetStreamingRecord.h"
+#include "AssetStreamingRequest.h"
+#include "AssetStreamingRequestHandle.h"
+#include "AssetStreamingRequestOptions.h"
+#include "AssetStreamingSpatialHash.h"
+#include "AssetStreamingStaleRequests.h"
+#include "AssetStreamingTrace.h"
+#include "AssetUnloadQueue.h"
+#include "AssetWarmCache.h"
+#include "Async/Future.h"
+#include "Containers/Queue.h"
+#include "Engine/LatentActionManager.h"
 #include "Engine/StreamableManager.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "AssetStreamingSubsystem.generated.h"
 
 class UObject;
 class IAssetStreamingCallback;
-typedef TArray<FAssetHandlePair> FAssetHandleArray;
+class UAssetStreamingComponent;
+class IAssetRegistry;
+struct FAssetStreamingBatch;
 typedef TArray<TSharedRef<FStreamableHandle>> FStreamableHandleArray;
 
+// Native callback called once by asset loaded, with whether the asset was already loaded when requested.
+typedef TFunction<void(UObject* LoadedAsset, bool bWasAlreadyLoaded)> FAssetLoadedFunction;
+
+// Native callback called once when every asset of a request is loaded, with the loaded assets in request order.
+typedef TUniqueFunction<void(const TArray<UObject*>& LoadedAssets)> FAssetRequestLoadedFunction;
+
+// Broadcast when the size of the tracked assets rises above one of the configured watermarks.
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAssetStreamingWatermarkDelegate, int64, Watermark, int64, ResidentBytes);
+
 /**
  * Subsystem used to asynchronously load and unload assets when required.
+ * Settings can be overridden in the [/Script/SimpleAssetStreaming.AssetStreamingSubsystem] section of DefaultGame.ini.
  */
-UCLASS()
+UCLASS(Config = Game)
 class SIMPLEASSETSTREAMING_API UAssetStreamingSubsystem : public UGameInstanceSubsystem
 {
     GENERATED_BODY()
@@ -48,11 +85,111 @@ class SIMPLEASSETSTREAMING_API UAssetStreamingSubsystem : public UGameInstanceSu
 public:
 
     UAssetStreamingSubsystem()
-        : StreamableManager()
+        : OnMemoryWatermarkCrossed()
+        , StreamableManager()
         , UnloadDelaySeconds(5.0f) // Modify this to change the delay before assets are finally unloaded. Cannot be negative.
-        , RegisteredAssets()
-        , AssetRequestCount()
-        , KeepAlive()
+        , WarmCacheBudgetBytes(0) // Modify this to keep released assets in a warm cache instead of unloading them after a delay. Zero disables the cache.
+        , MemoryPressureAvailableBytes(0) // Modify this to flush the warm cache when available physical memory drops below it. Zero disables the check.
+        , PumpBudgetMs(2.0f) // Modify this to change the time spent each frame dispatching loaded callbacks and unloading assets. Zero disables the budget.
+        , ProximityCellSize(10000.0f) // Modify this to change the size of the spatial hash cells streaming components are bucketed in. Should be close to their usual exit radius.
+        , ProximityEvaluationsPerTick(512) // Modify this to change how many streaming components are evaluated each frame.
+        , bRecordStartupManifest(false) // Modify this to record the assets requested early in the session, preloaded by the next one.
+        , StartupManifestRecordSeconds(30.0f) // Modify this to change how long the startup manifest is recorded for.
+        , bPreloadStartupManifest(false) // Modify this to preload the assets of the startup manifest recorded by the previous session.
+        , StartupPreloadTimeoutSeconds(60.0f) // Modify this to change how long preloaded assets are held if no request adopts them.
+        , bEnablePredictivePrefetch(false) // Modify this to prefetch the assets usually requested right after the requested ones.
+        , PredictorTableSize(4096) // Modify this to change the number of assets the predictor keeps statistics for.
+        , PredictorWindowSeconds(1.0f) // Modify this to change how long after a request other requests count as its successors.
+        , PredictorMinConfidence(0.5f) // Modify this to change how often an asset must have followed a request to be prefetched.
+        , PrefetchTimeoutSeconds(5.0f) // Modify this to change how long prefetched assets are held if no request adopts them.
+        , MaxPrefetches(32) // Modify this to change the number of prefetches held at once.
+        , MemoryWatermarksBytes() // Modify this to be notified when the size of the tracked assets rises above these values.
+        , bReleaseRequestsOfDestroyedOwners(true) // Modify this to keep the requests of destroyed owners until they're released by hand.
+        , ReclaimThresholdBytes(0) // Modify this to request a garbage collection once this many bytes of assets were unloaded since the last one. Zero disables it.
+        , MinReclaimIntervalSeconds(5.0f) // Modify this to change the minimum time between the garbage collections we request.
+        , bRecordTrace(false) // Modify this to record a trace of the session, written when the subsystem is deinitialized.
+        , MaxTraceEvents(1048576) // Modify this to change the number of events a trace holds before recording stops.
+        , bSortLoadSubmissions(false) // Modify this to submit the new loads of a frame together, in the order their packages are stored on disk.
+        , LoadSubmissionWindowSeconds(0.0f) // Modify this to wait longer for new loads to sort together. Zero submits them on the next tick.
+        , ClassFilters() // Modify this to skip loading the asset classes a net mode doesn't need, i.e. textures and sounds on dedicated servers.
+        , ClassPolicies() // Modify this to give asset classes or paths their own unload delay, warm cache and default priority.
+        , StaleRequestAgeSeconds(0.0f) // Modify this to report the requests older than this, which were likely never released. Zero disables the audits.
+        , StaleRequestAuditIntervalSeconds(60.0f) // Modify this to change how often stale requests are looked for.
+        , bExpandDependencies(false) // Modify this to track the hard dependencies of requested assets as assets of the request, shared between requests.
+        , MaxExpandedDependencies(512) // Modify this to change the number of dependencies tracked per requested asset.
+        , WarmCache()
+        , PolicyWarmCaches()
+        , LastMemoryPressureCheckTime(0.0)
+        , bIsUnderMemoryPressure(false)
+        , UnloadQueue()
+        , ExpiredUnloads()
+        , NextExpiredUnloadIndex(0)
+        , Requests()
+        , FreeRequestSlots()
+        , ReleasedRecords()
+        , RequestedAssetsScratch()
+        , Records()
+        , RecordIndices()
+        , QueuedOperations()
+        , NextQueuedRequestIndex()
+        , QueuedRequestHandles()
+        , NumLoadWaiters(0)
+        , PendingCompletions()
+        , NextCompletionIndex(0)
+        , NumPumpFramesBehind(0)
+        , ProximityGrid()
+        , ProximityEntries()
+        , ActiveProximityEntries()
+        , ViewLocations()
+        , bHasViewLocationsOverride(false)
+        , ProximityCandidates()
+        , ProximityQueryScratch()
+        , NextProximityCandidate(0)
+        , ProximityCycle(0)
+        , MaxProximityExitRadius(0.0f)
+        , bIsRecordingStartupManifest(false)
+        , StartupRecordEndTime(0.0)
+        , StartupManifestPaths()
+        , RecordedStartupPaths()
+        , StartupPreloadHandle()
+        , PendingPreloadPaths()
+        , NumPreloadedAssets(0)
+        , StartupPreloadEndTime(0.0)
+        , Predictor()
+        , Prefetches()
+        , PrefetchExpiries()
+        , NextPrefetchExpiry(0)
+        , PredictionsScratch()
+        , PrefetchStats()
+        , LatencyHistogram()
+        , NumKeepAliveHandles(0)
+        , NumPendingUnloads(0)
+        , NumInFlightLoads(0)
+        , NumAlreadyLoadedHits(0)
+        , NumLoadMisses(0)
+        , TrackedResidentBytes(0)
+        , NumWatermarksCrossed(0)
+        , UnreachableBytes(0)
+        , LastReclaimTime(0.0)
+        , NumReclaims(0)
+        , bIsTrimReclaimPending(false)
+        , Trace()
+        , bIsRecordingTrace(false)
+        , LoadOrder()
+        , PendingLoads()
+        , PendingLoadsScratch()
+        , PendingLoadsSubmitTime(0.0)
+        , AssetRegistry(nullptr)
+        , CachedClassFilterIndex(INDEX_NONE)
+        , ExcludedClassCache()
+        , NumExcludedAssets(0)
+        , PolicyClassCache()
+        , Barriers()
+        , NextStaleRequestAuditTime(0.0)
+        , NumStaleRequests(0)
+        , StalePinnedBytes(0)
+        , Dependencies()
+        , NumExpandedDependencies(0)
     {}
 
     // Returns the singleton instance of the asset streaming subsystem.
@@ -62,33 +199,233 @@ public:
 
     virtual void Deinitialize() override;
 
+    // Returns the histogram of the time between asset requests and their loaded callback.
+    FORCEINLINE const FAssetStreamingLatencyHistogram& GetLatencyHistogram() const { return LatencyHistogram; }
+
+    // Returns the memory allocated by the subsystem's bookkeeping, excluding the assets themselves.
+    SIZE_T GetAllocatedSize() const;
+
+    // Returns how many predictive prefetches were issued, adopted by requests or wasted.
+    FORCEINLINE const FAssetStreamingPrefetchStats& GetPrefetchStats() const { return PrefetchStats; }
+
+    // Returns the size of every tracked asset in memory, including released assets that aren't unloaded yet.
+    FORCEINLINE int64 GetTrackedResidentBytes() const { return TrackedResidentBytes; }
+
+    /**
+     * Returns the size in memory of the assets referenced by a request. Assets that are still loading don't count yet.
+     * @param RequestHandle The handle returned by the streaming request.
+     * @returns The size of the request's assets, zero if the handle leads to no request.
+     */
+    int64 GetRequestResidentBytes(const FAssetStreamingRequestHandle& RequestHandle);
+
+    /**
+     * Returns the owners holding the most memory through their requests.
+     * Requests are grouped by tag, or by the class of their owner if they have no tag.
+     * @param MaxOwners The maximum number of owners to return. Zero or less returns every owner.
+     * @param OutOwners The owners, largest first.
+     */
+    void GetTopMemoryOwners(const int32 MaxOwners, TArray<FAssetStreamingOwnerMemory>& OutOwners) const;
+
+    /**
+     * Finds the requests that were likely never released: those older than an age, and those whose owner was garbage collected.
+     * @param MinAgeSeconds How old requests must be to count as stale.
+     * @param OutStaleRequests The stale requests grouped by owner and callsite, those pinning the most memory first.
+     * @returns The number of stale requests.
+     */
+    int32 FindStaleRequests(const float MinAgeSeconds, TArray<FAssetStreamingStaleRequests>& OutStaleRequests) const;
+
+    // Called when the size of the tracked assets rises above one of the configured watermarks.
+    UPROPERTY(BlueprintAssignable, Category = "Asset Streaming")
+    FAssetStreamingWatermarkDelegate OnMemoryWatermarkCrossed;
+
+    // Returns the loaded callbacks and unloads the pump carried over to the next frame, and for how many frames it has been behind.
+    FAssetStreamingPumpBacklog GetPumpBacklog() const;
+
+    // Starts recording the requests, releases, loads and unloads to a trace, dropping any trace recorded earlier.
+    void StartTraceRecording();
+
+    /**
+     * Stops recording the trace and writes it to disk. Replay it with the AssetStreamingReplay commandlet.
+     * @param Filename The file to write. Defaults to FAssetStreamingTrace::GetDefaultFilename().
+     * @returns True if the trace was written.
+     */
+    bool StopTraceRecording(const FString& Filename = FString());
+
+    FORCEINLINE bool IsRecordingTrace() const { return bIsRecordingTrace; }
+
     /**
      * Request streaming of multiple assets.
      * Each asset will be streamed one by one.
      * @param AssetsToStream The assets to asynchronously stream.
      * @param AssetLoadedCallback The callback to call when an asset is loaded. Will be called once by asset loaded.
-     * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param OutRequestHandle The request handle assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @param Options Who the request belongs to, used by the memory queries.
      * @returns True if the request was successful.
      */
-    bool RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId);
+    bool RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
 
     /**
      * Request streaming of a single asset.
      * @param AssetToStream The asset to asynchronously stream.
      * @param AssetLoadedCallback The callback to call when an asset is loaded.
-     * @param OutAssetRequestId The request id assigned for your request. Use it to release the asset you streamed. Invalidated if the request was invalid.
+     * @param OutRequestHandle The request handle assigned for your request. Use it to release the asset you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @param Options Who the request belongs to, used by the memory queries.
+     * @returns True if the request was successful.
+     */
+    bool RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
+
+    /**
+     * Request streaming of multiple assets as a single batch.
+     * All assets are sent to the streamable manager in one request and share a single handle, which lets the loader group package loads.
+     * Reference counting is still done per asset.
+     * @param AssetsToStream The assets to asynchronously stream. Duplicates are ignored.
+     * @param AssetLoadedCallback The callback to call when assets are loaded. OnAssetLoaded is called once by asset loaded, OnAssetBatchLoaded once the whole batch is loaded.
+     * @param OutRequestHandle The request handle assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @param Options Who the request belongs to, used by the memory queries.
      * @returns True if the request was successful.
      */
-    bool RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId);
+    bool RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
+
+    /**
+     * Request streaming of multiple assets, with native callbacks instead of the callback interface.
+     * Assets are streamed as a single batch. Callbacks aren't called anymore once the request is released.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param OutRequestHandle The request handle assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param OnRequestLoaded Called once when every asset is loaded, with the assets in request order. Assets that failed to load are null.
+     * @param Priority The priority class to stream the assets with.
+     * @param OnAssetLoaded Optional, called once by asset loaded.
+     * @param Options Who the request belongs to, used by the memory queries.
+     * @returns True if the request was successful.
+     */
+    bool RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FAssetStreamingRequestHandle& OutRequestHandle, FAssetRequestLoadedFunction&& OnRequestLoaded, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, FAssetLoadedFunction&& OnAssetLoaded = nullptr, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
+
+    /**
+     * Request streaming of multiple assets, returning a future resolved once every asset is loaded.
+     * Assets are streamed as a single batch.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param OutRequestHandle The request handle assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @param Options Who the request belongs to, used by the memory queries.
+     * @returns The future of the loaded assets, in request order. Resolved with no assets if the request fails or is released before it is loaded.
+     */
+    TFuture<TArray<UObject*>> RequestAssetStreamingAsync(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FAssetStreamingRequestHandle& OutRequestHandle, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
 
     /**
      * Release the asset you streamed.
      * Warning: must be called when you don't need the streamed assets anymore!
-     * @param RequestId The id returned by the streaming request. Will be invalidated after releasing assets.
+     * @param RequestHandle The handle returned by the streaming request. Will be invalidated after releasing assets.
      * @returns True if releasing was successful.
      */
+    bool ReleaseAssets(FAssetStreamingRequestHandle& RequestHandle);
+
+    /**
+     * Release every request made on behalf of an owner in a single pass, i.e. when it is destroyed or on level transitions.
+     * Assets shared by the requests are only scheduled for unloading once. Handles to the released requests become stale.
+     * @param Owner The owner the requests were made for, see FAssetStreamingRequestOptions.
+     * @returns The number of released requests.
+     */
+    int32 ReleaseAllForOwner(const UObject* Owner);
+
+    /**
+     * Release every request tagged with a group in a single pass.
+     * Assets shared by the requests are only scheduled for unloading once. Handles to the released requests become stale.
+     * @param Tag The tag the requests were made with, see FAssetStreamingRequestOptions.
+     * @returns The number of released requests.
+     */
+    int32 ReleaseGroup(const FName Tag);
+
+    /**
+     * Raise the priority of a request whose assets are still loading.
+     * Assets that are already loaded are left untouched. Lowering the priority of a request isn't supported.
+     * @param RequestHandle The handle returned by the streaming request.
+     * @param NewPriority The priority class to stream the remaining assets with.
+     * @returns True if the priority of the request was raised.
+     */
+    bool RaiseRequestPriority(const FAssetStreamingRequestHandle& RequestHandle, const EAssetStreamingPriority NewPriority);
+
+    /**
+     * Wait for requests to finish loading, i.e. behind a loading screen. Their remaining loads are raised to Critical priority right away.
+     * Assets that failed to load count as finished, assets excluded by the class filters aren't waited for.
+     * @param RequestHandles The handles returned by the streaming requests.
+     * @param TimeoutSeconds How long to wait at most. Zero or less waits until the requests are loaded or released.
+     * @returns A future resolved on the game thread: true once nothing of the requests is loading anymore, false at the deadline or if a request is released first.
+     */
+    TFuture<bool> WaitForRequests(const TArray<FAssetStreamingRequestHandle>& RequestHandles, const float TimeoutSeconds);
+
+    /**
+     * Block the game thread until requests finish loading, flushing their loads. Meant for the hitches the game already accepts, i.e. seamless travel.
+     * Loaded callbacks may run during the wait. Their remaining loads are raised to Critical priority first.
+     * @param RequestHandles The handles returned by the streaming requests.
+     * @param TimeoutSeconds How long to block at most. Zero or less blocks until the requests are loaded.
+     * @returns True if nothing of the requests is loading anymore.
+     */
+    bool WaitForRequestsBlocking(const TArray<FAssetStreamingRequestHandle>& RequestHandles, const float TimeoutSeconds);
+
+    /**
+     * Returns how much of a request is loaded. Assets that failed to load count as loaded.
+     * @param RequestHandle The handle returned by the streaming request.
+     * @returns From 0 to 1, zero if the handle leads to no request.
+     */
+    float GetRequestProgress(const FAssetStreamingRequestHandle& RequestHandle);
+
+    /**
+     * Queue a request to stream assets. Thread-safe, never blocks.
+     * The request is submitted on the game thread during the next tick, and the callback is called on the game thread.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param AssetLoadedCallback The callback to call when assets are loaded.
+     * @param Priority The priority class to stream the assets with.
+     * @param bAsBatch Whether to stream the assets as a single batch, see RequestAssetBatchStreaming().
+     * @param Options Who the request belongs to, used by the memory queries.
+     * @returns The handle of the request, usable right away to release it. Invalid if there is nothing to stream.
+     */
+    FAssetStreamingRequestHandle EnqueueAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const bool bAsBatch = false, const FAssetStreamingRequestOptions& Options = FAssetStreamingRequestOptions());
+
+    /**
+     * Queue the release of a request. Thread-safe, never blocks.
+     * The request is released on the game thread during the next tick, after every operation queued before it.
+     * @param RequestHandle The handle of the request to release, queued or not.
+     */
+    void EnqueueReleaseAssets(const FAssetStreamingRequestHandle& RequestHandle);
+
+    /**
+     * Starts streaming the assets of a component whenever a view gets close to it. Called by the component when it begins play.
+     * @param Component The component to evaluate against the view locations.
+     */
+    void RegisterStreamingComponent(UAssetStreamingComponent* Component);
+
+    /**
+     * Stops evaluating a component, releasing its assets if they were streamed. Called by the component when it ends play.
+     * @param Component The registered component.
+     */
+    void UnregisterStreamingComponent(UAssetStreamingComponent* Component);
+
+    /**
+     * Evaluates streaming components against these locations instead of the player view points, i.e. for cinematics or loading screens.
+     * @param Locations The view locations to use until the override is cleared.
+     */
+    void SetViewLocationsOverride(const TArray<FVector>& Locations);
+
+    // Goes back to evaluating streaming components against the player view points.
+    void ClearViewLocationsOverride();
+
+    // Compatibility overload using a request guid, as done by the Blueprint API.
+    bool RequestAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    // Compatibility overload using a request guid, as done by the Blueprint API.
+    bool RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    // Compatibility overload using a request guid, as done by the Blueprint API.
+    bool RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    // Compatibility overload using a request guid, as done by the Blueprint API.
     bool ReleaseAssets(FGuid& RequestId);
 
+    // Compatibility overload using a request guid, as done by the Blueprint API.
+    bool RaiseRequestPriority(const FGuid& RequestId, const EAssetStreamingPriority NewPriority);
+
 protected:
 
     /**
@@ -96,10 +433,11 @@ protected:
      * Each asset will be streamed one by one.
      * @param AssetsToStream The assets to asynchronously stream.
      * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
      * @returns True if the request was successful.
      */
     UFUNCTION(BlueprintCallable, DisplayName = "Request Multiple Assets", Category = "Asset Streaming Functions")
-    bool K2_RequestMultipleAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId);
+    bool K2_RequestMultipleAssetStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
 
     /**
      * Request streaming of multiple assets.
@@ -107,19 +445,44 @@ protected:
      * @param AssetsToStream The assets to asynchronously stream.
      * @param AssetLoadedCallback The callback to call when an asset is loaded. Will be called once by asset loaded.
      * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
      * @returns True if the request was successful.
      */
     UFUNCTION(BlueprintCallable, DisplayName = "Request Multiple Assets w/Callback", Category = "Asset Streaming Functions")
-    bool K2_RequestMultipleAssetStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId);
+    bool K2_RequestMultipleAssetStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    /**
+     * Request streaming of multiple assets as a single batch.
+     * All assets share a single streamable handle.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @returns True if the request was successful.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Batch", Category = "Asset Streaming Functions")
+    bool K2_RequestAssetBatchStreaming(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    /**
+     * Request streaming of multiple assets as a single batch.
+     * All assets share a single streamable handle.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param AssetLoadedCallback The callback to call when assets are loaded. OnAssetLoaded is called once by asset loaded, OnAssetBatchLoaded once the whole batch is loaded.
+     * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @returns True if the request was successful.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Batch w/Callback", Category = "Asset Streaming Functions")
+    bool K2_RequestAssetBatchStreamingWithCallback(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
 
     /**
      * Request streaming of a single asset.
      * @param AssetToStream The asset to asynchronously stream.
      * @param OutAssetRequestId The request id assigned for your request. Use it to release the asset you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
      * @returns True if the request was successful.
      */
     UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Streaming", Category = "Asset Streaming Functions")
-    bool K2_RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, FGuid& OutAssetRequestId);
+    bool K2_RequestAssetStreaming(const TSoftObjectPtr<UObject>& AssetToStream, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
 
 
     /**
@@ -127,10 +490,64 @@ protected:
      * @param AssetToStream The asset to asynchronously stream.
      * @param AssetLoadedCallback The callback to call when an asset is loaded.
      * @param OutAssetRequestId The request id assigned for your request. Use it to release the asset you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
      * @returns True if the request was successful.
      */
     UFUNCTION(BlueprintCallable, DisplayName = "Request Asset Streaming w/Callback", Category = "Asset Streaming Functions")
-    bool K2_RequestAssetStreamingWithCallback(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId);
+    bool K2_RequestAssetStreamingWithCallback(const TSoftObjectPtr<UObject>& AssetToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal);
+
+    /**
+     * Request streaming of multiple assets on behalf of an owner or a tag, which the memory queries report them under.
+     * @param AssetsToStream The assets to asynchronously stream.
+     * @param AssetLoadedCallback The callback to call when assets are loaded. Can be left empty.
+     * @param Options Who the request belongs to.
+     * @param OutAssetRequestId The request id assigned for your request. Use it to release the assets you streamed. Invalidated if the request was invalid.
+     * @param Priority The priority class to stream the assets with.
+     * @param bAsBatch Whether to stream the assets as a single batch.
+     * @returns True if the request was successful.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Request Assets w/Options", Category = "Asset Streaming Functions")
+    bool K2_RequestAssetStreamingWithOptions(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const FAssetStreamingRequestOptions& Options, FGuid& OutAssetRequestId, const EAssetStreamingPriority Priority = EAssetStreamingPriority::Normal, const bool bAsBatch = false);
+
+    /**
+     * Release every request made on behalf of an owner in a single pass.
+     * @param Owner The owner the requests were made for.
+     * @returns The number of released requests.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Release All For Owner", Category = "Asset Streaming Functions")
+    int32 K2_ReleaseAllForOwner(const UObject* Owner);
+
+    /**
+     * Release every request tagged with a group in a single pass.
+     * @param Tag The tag the requests were made with.
+     * @returns The number of released requests.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Release Group", Category = "Asset Streaming Functions")
+    int32 K2_ReleaseGroup(const FName Tag);
+
+    /**
+     * Returns the size in memory of the assets referenced by a request.
+     * @param RequestId The id returned by the streaming request.
+     * @returns The size of the request's assets in bytes, zero if the id leads to no request.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Get Request Resident Bytes", Category = "Asset Streaming Functions")
+    int64 K2_GetRequestResidentBytes(const FGuid& RequestId);
+
+    /**
+     * Returns the owners holding the most memory through their requests, largest first.
+     * @param MaxOwners The maximum number of owners to return. Zero or less returns every owner.
+     * @returns The owners and the memory they hold.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Get Top Memory Owners", Category = "Asset Streaming Functions")
+    TArray<FAssetStreamingOwnerMemory> K2_GetTopMemoryOwners(const int32 MaxOwners = 10) const;
+
+    /**
+     * Finds the requests older than an age, or whose owner was garbage collected, grouped by owner and callsite.
+     * @param MinAgeSeconds How old requests must be to count as stale.
+     * @returns The stale requests, those pinning the most memory first.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Find Stale Requests", Category = "Asset Streaming Functions")
+    TArray<FAssetStreamingStaleRequests> K2_FindStaleRequests(const float MinAgeSeconds = 300.0f) const;
 
     /**
      * Release the asset you streamed.
@@ -141,19 +558,228 @@ protected:
     UFUNCTION(BlueprintCallable, DisplayName = "Release Assets", Category = "Asset Streaming Functions")
     bool K2_ReleaseAssets(UPARAM(Ref) FGuid& RequestId);
 
+    /**
+     * Raise the priority of a request whose assets are still loading.
+     * @param RequestId The id returned by the streaming request.
+     * @param NewPriority The priority class to stream the remaining assets with.
+     * @returns True if the priority of the request was raised.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Raise Request Priority", Category = "Asset Streaming Functions")
+    bool K2_RaiseRequestPriority(const FGuid& RequestId, const EAssetStreamingPriority NewPriority);
+
+    /**
+     * Wait for requests to finish loading, raising their remaining loads to Critical priority.
+     * @param WorldContextObject The object whose world runs the latent action.
+     * @param RequestIds The ids returned by the streaming requests.
+     * @param TimeoutSeconds How long to wait at most. Zero or less waits until the requests are loaded or released.
+     * @param bOutCompleted True if the requests finished loading, false at the deadline or if a request was released first.
+     * @param LatentInfo The latent action, filled by Blueprints.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Wait For Requests", Category = "Asset Streaming Functions", meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject"))
+    void K2_WaitForRequests(UObject* WorldContextObject, const TArray<FGuid>& RequestIds, const float TimeoutSeconds, bool& bOutCompleted, FLatentActionInfo LatentInfo);
+
+    /**
+     * Returns how much of a request is loaded.
+     * @param RequestId The id returned by the streaming request.
+     * @returns From 0 to 1, zero if the id leads to no request.
+     */
+    UFUNCTION(BlueprintCallable, DisplayName = "Get Request Progress", Category = "Asset Streaming Functions")
+    float K2_GetRequestProgress(const FGuid& RequestId);
+
 private:
 
-    void StreamAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FGuid& RequestId, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback);
+    // Gives the automation tests access to the internals of the subsystem.
+    friend class FAssetStreamingTestAccess;
+
+    void StreamAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FAssetStreamingRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority);
+
+    // Streams an asset right away, or queues it for the next sorted submission if it needs a new load and bSortLoadSubmissions is enabled.
+    void StreamOrQueueAsset(const TSoftObjectPtr<UObject>& AssetToStream, const FAssetStreamingRequestHandle& RequestHandle, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const EAssetStreamingPriority Priority);
+
+    // Streams the queued loads of the requests that are still active, highest priority first, then in the order their packages are stored.
+    void SubmitPendingLoads();
+
+    bool StreamAssetBatch(const TArray<TSoftObjectPtr<UObject>>& AssetsToStream, const FAssetStreamingRequestHandle& RequestHandle, const TSharedRef<FAssetStreamingBatch>& Batch, const EAssetStreamingPriority Priority);
+
+    // Registers the hard dependencies of the requested assets to the request, without callbacks. Each dependency is referenced once per request.
+    void StreamDependencies(const TArrayView<const TSoftObjectPtr<UObject>> RequestedAssets, const FAssetStreamingRequestHandle& RequestHandle, const EAssetStreamingPriority Priority);
 
-    void RegisterAssetToId(const TSoftObjectPtr<UObject>& Asset, const TSharedPtr<FStreamableHandle> Handle, const FGuid& Id);
+    // Assigns a free request slot to a new request.
+    FAssetStreamingRequestHandle AllocateRequest(const EAssetStreamingPriority Priority, const FAssetStreamingRequestOptions& Options);
 
-    void IncrementAssetReference(const TSoftObjectPtr<UObject>& Asset);
+    // Returns the request the handle points to, or null if the handle is stale.
+    FAssetStreamingRequest* FindRequest(const FAssetStreamingRequestHandle& RequestHandle);
+
+    // Frees the slot of a request, invalidating every handle to it.
+    void FreeRequest(const FAssetStreamingRequestHandle& RequestHandle);
+
+    // Releases the active requests matching a predicate, then unloads the assets nothing references anymore. Returns the number of released requests.
+    int32 ReleaseRequestsIf(TFunctionRef<bool(const FAssetStreamingRequest&)> Predicate);
+
+    // Releases an active request, single or in bulk: drops its references, collecting the assets nothing references anymore in ReleasedRecords, then frees its slot and queued handle.
+    void ReleaseRequest(const FAssetStreamingRequestHandle& SlotHandle);
+
+    // Drops the references of a request to its assets, collecting the ones nothing references anymore in ReleasedRecords.
+    void ReleaseRequestReferences(const FAssetStreamingRequest& Request);
+
+    // Moves the assets collected in ReleasedRecords to the warm cache or the unload queue.
+    void UnloadReleasedRecords();
+
+    // Releases the requests whose owner was garbage collected, and resets the size of the unloaded assets awaiting collection.
+    void HandlePostGarbageCollect();
+
+    // Asks the engine for a garbage collection at the start of its next tick, to reclaim the memory of unloaded assets. Throttled.
+    void RequestReclaim();
+
+    // Converts a priority class to the async load priority used by the streamable manager.
+    static TAsyncLoadPriority GetAsyncLoadPriority(const EAssetStreamingPriority Priority);
+
+    // Returns the index of the record of an asset, creating the record if the asset isn't tracked yet.
+    int32 FindOrAddRecord(const FSoftObjectPath& AssetPath);
+
+    /**
+     * Adds a reference to an asset, taking it back from the warm cache or the unload queue.
+     * @param RecordIndex The index of the asset's record.
+     * @param Handle The handle that loaded the asset. Becomes the keep-alive handle if the asset has none.
+     */
+    void AddAssetReference(const int32 RecordIndex, const TSharedPtr<FStreamableHandle>& Handle);
+
+    // Calls back the requests waiting for the pending load of an asset.
+    void NotifyLoadWaiters(const FSoftObjectPath& AssetPath);
+
+    // Measures the load latency of an asset, if it had to be loaded.
+    void RecordLoadLatency(const TSoftObjectPtr<UObject>& LoadedAsset, const bool bAlreadyLoaded, const double RequestTime);
+
+    /**
+     * Dispatches queued loaded callbacks and expired unloads until the frame budget runs out. Leftovers are carried over to the next frame.
+     * Each queue makes progress by at least one item per frame, so neither can starve the other.
+     */
+    void Pump();
 
-    void HandleAssetLoaded(const TSoftObjectPtr<UObject>& LoadedAsset, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const bool& bAlreadyLoaded);
+    void DispatchCompletion(const FAssetStreamingCompletion& Completion);
 
-    void ScheduleAssetUnloading(const FAssetHandleArray& Assets);
+    // Calls the loaded callback of an asset. Excluded assets are called back without being loaded.
+    void HandleAssetLoaded(const TSoftObjectPtr<UObject>& LoadedAsset, const TScriptInterface<IAssetStreamingCallback>& AssetLoadedCallback, const bool bAlreadyLoaded, const bool bIsExcluded);
 
-    void FinalUnloadAssets(const FAssetHandleArray& Assets);
+    // Returns true if the class of an asset is excluded in the current net mode. The class is read from the asset registry, without loading the asset.
+    bool IsAssetClassExcluded(const FSoftObjectPath& AssetPath);
+
+    // Returns the name of the current net mode, as used by the class filters.
+    FName GetNetModeName() const;
+
+    void HandleBatchUpdated(const TSharedRef<FAssetStreamingBatch>& Batch);
+
+    void HandleBatchLoaded(const TSharedRef<FAssetStreamingBatch>& Batch);
+
+    // Returns true if the handle is the keep-alive handle of at least one asset. Batch handles can keep multiple assets alive.
+    bool IsKeepAliveHandle(const TSharedPtr<FStreamableHandle>& Handle, const int32 RecordIndex);
+
+    // Queues a released asset for unloading after the delay of its policy. Right away under memory pressure, if its policy allows it, or when evicted from a warm cache.
+    void ScheduleAssetUnloading(const int32 RecordIndex, const bool bUnloadNow = false);
+
+    // Unloads the assets whose delay has expired.
+    bool Tick(float DeltaTime);
+
+    // Moves a released asset to the warm cache of its policy. Call EnforceWarmCacheBudget() once done caching assets.
+    void CacheReleasedAsset(const int32 RecordIndex);
+
+    // Evicts assets from the warm caches until they fit their budget. Evicts everything under memory pressure, except the assets of policies opting out.
+    // Evicted assets are queued for the pump, which unloads them within its budget.
+    void EnforceWarmCacheBudget(const bool bFlush = false);
+
+    // Evicts the least recently used assets of a warm cache until it fits the budget, or every asset.
+    void EvictFromWarmCache(FAssetWarmCache& Cache, const int64 BudgetBytes, const bool bEvictAll, TArray<int32>& OutEvictedAssets);
+
+    // Returns the warm cache of a class policy, or the subsystem's one for INDEX_NONE.
+    FORCEINLINE FAssetWarmCache& GetWarmCache(const int32 PolicyIndex) { return PolicyIndex == INDEX_NONE ? WarmCache : PolicyWarmCaches[PolicyIndex]; }
+
+    // Returns the number of assets in every warm cache.
+    int32 GetNumWarmCachedAssets() const;
+
+    // Returns true if the platform is running low on physical memory. Throttled to avoid polling the platform on every release.
+    bool IsUnderMemoryPressure();
+
+    // Returns true if nothing of a request is loading anymore, or queued to be. False if the handle leads to no request.
+    bool IsRequestComplete(const FAssetStreamingRequestHandle& RequestHandle);
+
+    // Raises the remaining loads of requests to Critical priority, submitting their queued loads right away.
+    void BoostRequests(const TArray<FAssetStreamingRequestHandle>& RequestHandles);
+
+    // Resolves the barriers whose requests completed, were released or whose deadline passed.
+    void UpdateBarriers();
+
+    // Drops the invalid class policies, and sets up their warm caches and the asset registry they may need.
+    void InitializeClassPolicies();
+
+    // Returns the index of the first class policy matching an asset, or INDEX_NONE. The class is read from the asset registry, without loading the asset.
+    int32 FindClassPolicy(const FSoftObjectPath& AssetPath);
+
+    void HandleMemoryTrim();
+
+    // Submits the requests and releases queued by other threads, in order.
+    void ProcessQueuedOperations();
+
+    // Evaluates the next slice of streaming components, starting a new cycle once every candidate of the previous one was evaluated.
+    void EvaluateProximity();
+
+    // Gathers the view locations, then the components close enough to them or already streaming.
+    void StartProximityCycle();
+
+    // Requests or releases the assets of a component depending on its distance to the closest view.
+    void EvaluateProximityEntry(const int32 EntryIndex);
+
+    void RemoveProximityEntry(const int32 EntryIndex);
+
+    // Requests the assets of the startup manifest as a single background batch, held until they're adopted or the timeout expires.
+    void StartStartupPreload();
+
+    // Records an asset request for the startup manifest, and hands preloaded assets over to the request.
+    void HandleStartupRequest(const FSoftObjectPath& AssetPath);
+
+    // Stops recording and writes the startup manifest.
+    void FinishStartupRecording();
+
+    // Releases the preloaded assets that no request adopted.
+    void ReleaseStartupPreload();
+
+    // Hands a prefetched asset over to its request, then prefetches the assets predicted to follow it.
+    void HandlePredictedRequest(const FSoftObjectPath& AssetPath);
+
+    // Speculatively loads an asset at background priority, without referencing it.
+    void PrefetchAsset(const FSoftObjectPath& AssetPath);
+
+    // Drops the prefetches no request adopted in time, counting them as wasted.
+    void ExpirePrefetches();
+
+    // Drops every prefetch, i.e. when the platform asks us to free memory.
+    void DropPrefetches();
+
+    // Measures the size of a loaded asset in memory, if it wasn't measured yet.
+    void MeasureResidentBytes(const int32 RecordIndex);
+
+    // Changes the measured size of an asset, updating the total. Watermarks are checked by the next tick.
+    void SetResidentBytes(const int32 RecordIndex, const int64 ResidentBytes);
+
+    // Broadcasts the watermarks the tracked assets rose above, and rearms the ones they dropped below.
+    void UpdateMemoryWatermarks();
+
+    // Returns the name the memory of a request is reported under: its tag, or the class of its owner.
+    static FName GetMemoryOwnerName(const FAssetStreamingRequest& Request);
+
+    // Logs the stale requests and the memory they pin, for the long sessions that slowly leak requests.
+    void AuditStaleRequests();
+
+    // Returns the handle of the request slot of a queued request, submitting the queue if needed. Other handles are returned as is.
+    FAssetStreamingRequestHandle ResolveRequestHandle(const FAssetStreamingRequestHandle& RequestHandle);
+
+    // Cancels a handle that doesn't keep any asset alive.
+    void CancelHandle(const TSharedPtr<FStreamableHandle>& Handle);
+
+    // Publishes the gauges to the stats system and the CSV profiler.
+    void UpdateStats();
+
+    // Stops tracking an asset whose references dropped to zero, cancelling its keep-alive handle.
+    void FinalUnloadAsset(const int32 RecordIndex);
 
     // Singleton instance.
     static UAssetStreamingSubsystem* Instance;
@@ -162,14 +788,336 @@ private:
     FStreamableManager StreamableManager;
 
     // The amount of time to wait before finally unloading an asset when its references drop to zero.
+    UPROPERTY(Config)
     float UnloadDelaySeconds;
 
-    // Maps request guid to the requested assets and their handle.
-    TMap<FGuid, FAssetHandleArray> RegisteredAssets;
+    // The maximum size of the released assets kept in the warm cache. Zero disables the warm cache.
+    UPROPERTY(Config)
+    int64 WarmCacheBudgetBytes;
+
+    // The warm cache is flushed when the available physical memory drops below this value. Zero disables the check.
+    UPROPERTY(Config)
+    int64 MemoryPressureAvailableBytes;
+
+    // The time in milliseconds the subsystem may spend each frame dispatching loaded callbacks and unloading assets. Zero disables the budget.
+    UPROPERTY(Config)
+    float PumpBudgetMs;
+
+    // The size of the spatial hash cells streaming components are bucketed in.
+    UPROPERTY(Config)
+    float ProximityCellSize;
+
+    // The number of streaming components evaluated each frame. A cycle evaluating every candidate is spread over as many frames as needed.
+    UPROPERTY(Config)
+    int32 ProximityEvaluationsPerTick;
+
+    // Whether to record the assets requested during the first seconds of the session to the startup manifest.
+    UPROPERTY(Config)
+    bool bRecordStartupManifest;
+
+    // How long after initialization requests are recorded to the startup manifest.
+    UPROPERTY(Config)
+    float StartupManifestRecordSeconds;
+
+    // Whether to preload the assets of the startup manifest when the subsystem is initialized.
+    UPROPERTY(Config)
+    bool bPreloadStartupManifest;
+
+    // How long preloaded assets are held if no request adopts them.
+    UPROPERTY(Config)
+    float StartupPreloadTimeoutSeconds;
+
+    // Whether to learn which assets follow each other and prefetch them.
+    UPROPERTY(Config)
+    bool bEnablePredictivePrefetch;
+
+    // The number of assets the predictor keeps statistics for. Its memory is allocated once.
+    UPROPERTY(Config)
+    int32 PredictorTableSize;
+
+    // How long after a request other requests count as its successors.
+    UPROPERTY(Config)
+    float PredictorWindowSeconds;
+
+    // The share of an asset's requests a successor must have followed to be prefetched, between 0 and 1.
+    UPROPERTY(Config)
+    float PredictorMinConfidence;
+
+    // How long prefetched assets are held if no request adopts them.
+    UPROPERTY(Config)
+    float PrefetchTimeoutSeconds;
+
+    // The maximum number of prefetches held at once.
+    UPROPERTY(Config)
+    int32 MaxPrefetches;
+
+    // The sizes of the tracked assets above which OnMemoryWatermarkCrossed is broadcast, i.e. +MemoryWatermarksBytes=1073741824.
+    UPROPERTY(Config)
+    TArray<int64> MemoryWatermarksBytes;
+
+    // Whether to release the requests of owners that were garbage collected, checked after every garbage collection.
+    UPROPERTY(Config)
+    bool bReleaseRequestsOfDestroyedOwners;
+
+    // The size of the assets unloaded since the last garbage collection above which we request one. Zero disables it.
+    UPROPERTY(Config)
+    int64 ReclaimThresholdBytes;
+
+    // The minimum time between the garbage collections we request, so that unload waves don't cause collection storms.
+    UPROPERTY(Config)
+    float MinReclaimIntervalSeconds;
+
+    // Whether to record a trace from initialization, see StartTraceRecording().
+    UPROPERTY(Config)
+    bool bRecordTrace;
+
+    // The number of events after which recording stops, bounding the memory of the trace.
+    UPROPERTY(Config)
+    int32 MaxTraceEvents;
+
+    // Whether to hold the new loads of single requests until the submission window closes, and submit them sorted by location on disk.
+    UPROPERTY(Config)
+    bool bSortLoadSubmissions;
+
+    // How long new loads wait for others to be sorted with, from the first one queued. Critical requests never wait.
+    UPROPERTY(Config)
+    float LoadSubmissionWindowSeconds;
+
+    // Asset classes that aren't loaded in some net modes, i.e. +ClassFilters=(NetMode=DedicatedServer,ExcludedClasses=("Texture","SoundBase")).
+    UPROPERTY(Config)
+    TArray<FAssetStreamingClassFilter> ClassFilters;
+
+    // Settings overriding the subsystem-wide ones for some asset classes or paths, i.e. +ClassPolicies=(AssetClass="SoundCue",UnloadDelaySeconds=60.0).
+    // The first policy matching an asset applies, when the asset starts being tracked.
+    UPROPERTY(Config)
+    TArray<FAssetStreamingClassPolicy> ClassPolicies;
+
+    // Requests older than this are reported as stale by the periodic audits, along with those of destroyed owners. Zero disables the audits.
+    UPROPERTY(Config)
+    float StaleRequestAgeSeconds;
+
+    // The time between two stale request audits.
+    UPROPERTY(Config)
+    float StaleRequestAuditIntervalSeconds;
+
+    // Whether requests also reference the assets their assets hard depend on, according to the asset registry.
+    // Dependencies are then ref-counted like requested assets: kept alive and unloaded with the requests sharing them, and accounted for in memory reports.
+    UPROPERTY(Config)
+    bool bExpandDependencies;
+
+    // The maximum number of dependencies referenced for each requested asset, the closest ones first.
+    UPROPERTY(Config)
+    int32 MaxExpandedDependencies;
+
+    // Released assets kept alive until they're evicted.
+    FAssetWarmCache WarmCache;
+
+    // The warm cache of each class policy, budgeted separately.
+    TArray<FAssetWarmCache> PolicyWarmCaches;
+
+    // The last time we polled the platform for available memory.
+    double LastMemoryPressureCheckTime;
+
+    // Whether the platform was running low on memory when we last polled it.
+    bool bIsUnderMemoryPressure;
+
+    FDelegateHandle MemoryTrimHandle;
+
+    FDelegateHandle PostGarbageCollectHandle;
+
+    // Assets waiting for their unload delay to expire.
+    FAssetUnloadQueue UnloadQueue;
+
+    // Expired unloads waiting for the pump, starting at NextExpiredUnloadIndex.
+    TArray<FAssetUnloadQueue::FEntry> ExpiredUnloads;
+
+    int32 NextExpiredUnloadIndex;
+
+    FDelegateHandle TickHandle;
+
+    // Request slots, indexed by request handles. Released slots are reused.
+    TArray<FAssetStreamingRequest> Requests;
+
+    // Indices of the request slots that are free to reuse.
+    TArray<uint32> FreeRequestSlots;
+
+    // Scratch array reused by releases to collect records whose references dropped to zero.
+    TArray<int32> ReleasedRecords;
+
+    // Scratch array reused to check the assets requested by batch handles.
+    TArray<FSoftObjectPath> RequestedAssetsScratch;
+
+    // Records of every tracked asset, referenced by index from requests, the warm cache and the unload queue.
+    TSparseArray<FAssetStreamingRecord> Records;
+
+    // Maps asset paths to the index of their record. Only used when an asset is requested.
+    TMap<FSoftObjectPath, int32> RecordIndices;
+
+    // Requests and releases queued by other threads. Lock-free for producers, drained on the game thread.
+    TQueue<FAssetStreamingQueuedOperation, EQueueMode::Mpsc> QueuedOperations;
+
+    // Sequence number of the last queued request.
+    FThreadSafeCounter NextQueuedRequestIndex;
+
+    // Maps the handles of queued requests to the handle of their request slot, until their slot is freed.
+    TMap<FAssetStreamingRequestHandle, FAssetStreamingRequestHandle> QueuedRequestHandles;
+
+    // The number of requests waiting for the pending load of an asset, across every record.
+    uint32 NumLoadWaiters;
+
+    // Loaded callbacks waiting for the pump, starting at NextCompletionIndex.
+    TArray<FAssetStreamingCompletion> PendingCompletions;
+
+    int32 NextCompletionIndex;
+
+    // The number of consecutive ticks the pump ran out of budget.
+    uint32 NumPumpFramesBehind;
+
+    // Streaming components bucketed by location.
+    FAssetStreamingSpatialHash ProximityGrid;
+
+    // Every registered streaming component, referenced by index from the grid.
+    TSparseArray<FAssetStreamingProximityEntry> ProximityEntries;
+
+    // Entries evaluated every cycle wherever the views are: the ones streaming their assets, and movable ones.
+    TSet<int32> ActiveProximityEntries;
+
+    // The locations distances are measured from during the current cycle.
+    TArray<FVector> ViewLocations;
+
+    bool bHasViewLocationsOverride;
+
+    // Entries to evaluate during the current cycle, starting at NextProximityCandidate.
+    TArray<int32> ProximityCandidates;
+
+    // Scratch array reused to query the grid.
+    TArray<int32> ProximityQueryScratch;
+
+    int32 NextProximityCandidate;
+
+    // Incremented every time a cycle starts.
+    uint32 ProximityCycle;
+
+    // The largest exit radius of the registered components, used to query the grid.
+    float MaxProximityExitRadius;
+
+    bool bIsRecordingStartupManifest;
+
+    // When the startup manifest stops being recorded.
+    double StartupRecordEndTime;
+
+    // Assets requested since the startup manifest started being recorded, in request order.
+    TArray<FSoftObjectPath> StartupManifestPaths;
+
+    // The same assets, to only record each of them once.
+    TSet<FSoftObjectPath> RecordedStartupPaths;
+
+    // The handle holding the preloaded assets of the startup manifest.
+    TSharedPtr<FStreamableHandle> StartupPreloadHandle;
+
+    // Preloaded assets that no request adopted yet.
+    TSet<FSoftObjectPath> PendingPreloadPaths;
+
+    int32 NumPreloadedAssets;
+
+    // When the preloaded assets that weren't adopted are released.
+    double StartupPreloadEndTime;
+
+    FAssetStreamingPredictor Predictor;
+
+    // Speculative loads of predicted assets, kept apart from the records so that they can be dropped without touching them.
+    TMap<FSoftObjectPath, FAssetStreamingPrefetch> Prefetches;
+
+    // Prefetches in the order they expire, starting at NextPrefetchExpiry. Entries of adopted prefetches are skipped.
+    TArray<TPair<FSoftObjectPath, double>> PrefetchExpiries;
+
+    int32 NextPrefetchExpiry;
+
+    // Scratch array reused to collect the predictions of a request.
+    TArray<FSoftObjectPath> PredictionsScratch;
+
+    FAssetStreamingPrefetchStats PrefetchStats;
+
+    // Time between asset requests and their loaded callback. Only measured for assets that weren't already loaded.
+    FAssetStreamingLatencyHistogram LatencyHistogram;
+
+    // The number of assets holding a keep-alive handle.
+    uint32 NumKeepAliveHandles;
+
+    // The number of assets waiting in the unload queue.
+    uint32 NumPendingUnloads;
+
+    // The number of handles still loading assets. A batch counts as a single load.
+    uint32 NumInFlightLoads;
+
+    // The number of requested assets that were already loaded.
+    uint32 NumAlreadyLoadedHits;
+
+    // The number of requested assets that had to be loaded.
+    uint32 NumLoadMisses;
+
+    // The size of every tracked asset in memory, as measured when they were loaded.
+    int64 TrackedResidentBytes;
+
+    // The number of sorted watermarks the tracked assets are currently above.
+    int32 NumWatermarksCrossed;
+
+    // The size of the assets unloaded since the last garbage collection. They are unreachable, but still in memory.
+    int64 UnreachableBytes;
+
+    // The last time we requested a garbage collection.
+    double LastReclaimTime;
+
+    // The number of garbage collections we requested.
+    uint32 NumReclaims;
+
+    // Whether a trim is waiting for the pump to unload its evictions before requesting a garbage collection.
+    bool bIsTrimReclaimPending;
+
+    // Events recorded since StartTraceRecording(), kept in memory until the trace is written.
+    FAssetStreamingTrace Trace;
+
+    bool bIsRecordingTrace;
+
+    // Where the packages of the requested assets live on disk.
+    FAssetStreamingLoadOrder LoadOrder;
+
+    // New loads waiting for the submission window to close.
+    TArray<FAssetStreamingPendingLoad> PendingLoads;
+
+    // The loads being submitted. Loads queued by their callbacks go to the next window.
+    TArray<FAssetStreamingPendingLoad> PendingLoadsScratch;
+
+    // When the submission window closes.
+    double PendingLoadsSubmitTime;
+
+    // Used to read the class of requested assets. Only set if class filters or policies by class are configured.
+    IAssetRegistry* AssetRegistry;
+
+    // The class filter ExcludedClassCache was filled with. The net mode may change during the session.
+    int32 CachedClassFilterIndex;
+
+    // Whether each asset class met so far is excluded by the active class filter.
+    TMap<FName, bool> ExcludedClassCache;
+
+    // The number of requested assets that weren't loaded because of their class.
+    uint32 NumExcludedAssets;
+
+    // For each asset class met so far, which class policies match it, ignoring their path prefix.
+    TMap<FName, TBitArray<>> PolicyClassCache;
+
+    // Waits on sets of requests, checked every tick.
+    TArray<FAssetStreamingBarrier> Barriers;
+
+    double NextStaleRequestAuditTime;
+
+    // The number of stale requests found by the last audit, and the size of the assets only they reference.
+    uint32 NumStaleRequests;
+    int64 StalePinnedBytes;
 
-    // Maps asset paths to the number of requests they have.
-    TMap<FSoftObjectPath, int32> AssetRequestCount;
+    // The dependencies of the assets requested so far, when bExpandDependencies is enabled.
+    FAssetStreamingDependencies Dependencies;
 
-    // Handles to keep alive until we finally unload the asset.
-    TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> KeepAlive;
+    // The number of dependencies referenced by requests so far.
+    uint32 NumExpandedDependencies;
 };
@@ -0,0 +1,138 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EAssetStreamingTraceEvent : uint8
+{
+	// An asset was registered to a request.
+	Request,
+	// A request was released, dropping its references to every asset it registered.
+	Release,
+	// A requested asset was loaded and its size measured.
+	Loaded,
+	// An asset was finally unloaded.
+	Unloaded
+};
+
+struct FAssetStreamingTraceEntry
+{
+	// Seconds since the trace started.
+	double Time;
+
+	EAssetStreamingTraceEvent Type;
+
+	// The request slot of Request and Release events. Slots are only reused once released, so they identify the active requests.
+	uint32 RequestId;
+
+	// The index of the asset in the trace's asset paths. INDEX_NONE for Release events.
+	int32 AssetIndex;
+
+	// The measured size of the asset, for Loaded events.
+	int64 SizeBytes;
+};
+
+/**
+ * Compact binary trace of the requests, releases, loads and unloads of the subsystem.
+ * Recorded during a session, then replayed offline to compare streaming policies, see FAssetStreamingTraceReplay.
+ * Asset paths are stored once, events reference them by index and store their time as a delta from the previous one.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingTrace
+{
+public:
+
+	FAssetStreamingTrace()
+		: AssetPaths()
+		, AssetIndices()
+		, Entries()
+		, StartTime(0.0)
+	{}
+
+	// Returns where the subsystem writes traces by default.
+	static FString GetDefaultFilename();
+
+	/**
+	 * Drop the recorded events and start a new trace.
+	 * @param Now The current time, event times are relative to it.
+	 */
+	void Reset(const double Now);
+
+	void RecordRequest(const double Now, const uint32 RequestId, const FSoftObjectPath& AssetPath);
+
+	void RecordRelease(const double Now, const uint32 RequestId);
+
+	void RecordLoaded(const double Now, const FSoftObjectPath& AssetPath, const int64 SizeBytes);
+
+	void RecordUnloaded(const double Now, const FSoftObjectPath& AssetPath);
+
+	/**
+	 * Write the trace to disk, replacing any previous one.
+	 * @param Filename The file to write.
+	 * @returns True if the file was written.
+	 */
+	bool Save(const FString& Filename) const;
+
+	/**
+	 * Read a trace from disk, replacing the recorded events.
+	 * @param Filename The file to read.
+	 * @returns True if the file was read. The trace is left empty otherwise.
+	 */
+	bool Load(const FString& Filename);
+
+	// Returns the traced assets, indexed by the events.
+	FORCEINLINE const TArray<FSoftObjectPath>& GetAssetPaths() const { return AssetPaths; }
+
+	// Returns the events, in the order they were recorded.
+	FORCEINLINE const TArray<FAssetStreamingTraceEntry>& GetEntries() const { return Entries; }
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	// Returns the memory allocated by the trace.
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return AssetPaths.GetAllocatedSize() + AssetIndices.GetAllocatedSize() + Entries.GetAllocatedSize(); }
+
+private:
+
+	static constexpr uint32 Magic = 0x52545341; // "ASTR"
+
+	static constexpr uint32 Version = 1;
+
+	// Upper bound on the number of events of a file.
+	static constexpr int32 MaxEntries = 1 << 26;
+
+	int32 FindOrAddAsset(const FSoftObjectPath& AssetPath);
+
+	void AddEntry(const double Now, const EAssetStreamingTraceEvent Type, const uint32 RequestId, const int32 AssetIndex, const int64 SizeBytes);
+
+	TArray<FSoftObjectPath> AssetPaths;
+
+	TMap<FSoftObjectPath, int32> AssetIndices;
+
+	TArray<FAssetStreamingTraceEntry> Entries;
+
+	double StartTime;
+};
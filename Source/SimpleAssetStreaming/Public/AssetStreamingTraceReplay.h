@@ -0,0 +1,125 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAssetStreamingTrace;
+
+// The streaming settings a trace is replayed with.
+struct FAssetStreamingReplayPolicy
+{
+	FAssetStreamingReplayPolicy()
+		: UnloadDelaySeconds(5.0f)
+		, WarmCacheBudgetBytes(0)
+	{}
+
+	FAssetStreamingReplayPolicy(const float InUnloadDelaySeconds, const int64 InWarmCacheBudgetBytes)
+		: UnloadDelaySeconds(InUnloadDelaySeconds)
+		, WarmCacheBudgetBytes(InWarmCacheBudgetBytes)
+	{}
+
+	// See UAssetStreamingSubsystem::UnloadDelaySeconds.
+	float UnloadDelaySeconds;
+
+	// See UAssetStreamingSubsystem::WarmCacheBudgetBytes.
+	int64 WarmCacheBudgetBytes;
+};
+
+// How long simulated loads take: a fixed latency, plus the time to read the asset at the given bandwidth.
+struct FAssetStreamingReplayLatency
+{
+	FAssetStreamingReplayLatency()
+		: BaseMs(10.0f)
+		, MegabytesPerSecond(50.0f)
+	{}
+
+	float BaseMs;
+
+	// Zero or less ignores the size of the assets.
+	float MegabytesPerSecond;
+
+	// Returns the simulated load time of an asset, in seconds.
+	double GetLoadSeconds(const int64 SizeBytes) const
+	{
+		const double ReadSeconds = MegabytesPerSecond > 0.0f ? SizeBytes / (MegabytesPerSecond * 1024.0 * 1024.0) : 0.0;
+		return BaseMs * 0.001 + ReadSeconds;
+	}
+};
+
+struct FAssetStreamingReplayResult
+{
+	FAssetStreamingReplayResult()
+		: PeakTrackedBytes(0)
+		, NumRequestedAssets(0)
+		, NumHits(0)
+		, NumLoads(0)
+		, NumReloads(0)
+		, TotalWaitSeconds(0.0)
+	{}
+
+	// The largest size of the loaded assets tracked at once, including released assets that aren't unloaded yet.
+	int64 PeakTrackedBytes;
+
+	// The number of assets registered to requests.
+	uint32 NumRequestedAssets;
+
+	// The number of requested assets that were already loaded.
+	uint32 NumHits;
+
+	// The number of loads issued.
+	uint32 NumLoads;
+
+	// The number of loads of assets that were unloaded earlier in the trace.
+	uint32 NumReloads;
+
+	// The time requested assets waited for their load, hits waiting zero.
+	double TotalWaitSeconds;
+
+	float GetHitRate() const { return NumRequestedAssets > 0 ? static_cast<float>(NumHits) / NumRequestedAssets : 0.0f; }
+
+	// Returns the average wait of the requested assets, in milliseconds.
+	float GetAverageWaitMs() const { return NumRequestedAssets > 0 ? static_cast<float>(1000.0 * TotalWaitSeconds / NumRequestedAssets) : 0.0f; }
+};
+
+/**
+ * Replays the requests and releases of a trace against the reference counting, unload queue and warm cache of the subsystem, without loading anything.
+ * Loads take a simulated time depending on the size the trace measured for each asset. The recorded loads and unloads are only used for these sizes.
+ */
+class SIMPLEASSETSTREAMING_API FAssetStreamingTraceReplay
+{
+public:
+
+	/**
+	 * Replay a trace with a streaming policy.
+	 * @param Trace The recorded trace.
+	 * @param Policy The settings to replay the trace with.
+	 * @param Latency How long simulated loads take.
+	 * @returns What the policy would have cost over the trace.
+	 */
+	static FAssetStreamingReplayResult Run(const FAssetStreamingTrace& Trace, const FAssetStreamingReplayPolicy& Policy, const FAssetStreamingReplayLatency& Latency);
+};
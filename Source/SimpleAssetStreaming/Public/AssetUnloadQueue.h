@@ -0,0 +1,84 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Deadline sorted queue of assets waiting to be unloaded, identified by the index of their asset record.
+ * Each scheduled entry gets a serial that the record keeps as its pending-unload slot. Cancelling is O(1):
+ * the record forgets its serial, and the stale entry is skipped by the subsystem once it expires.
+ */
+class SIMPLEASSETSTREAMING_API FAssetUnloadQueue
+{
+public:
+
+	struct FEntry
+	{
+		double Deadline;
+		int32 RecordIndex;
+		uint32 Serial;
+	};
+
+	FAssetUnloadQueue()
+		: Heap()
+		, NextSerial(1)
+	{}
+
+	/**
+	 * Schedule an asset to be unloaded.
+	 * @param RecordIndex The index of the asset's record.
+	 * @param Deadline The time at which the asset should be unloaded, in seconds.
+	 * @returns The serial of the entry. Never zero.
+	 */
+	uint32 Schedule(const int32 RecordIndex, const double Deadline);
+
+	/**
+	 * Pop every entry whose deadline has passed, including stale ones.
+	 * @param Now The current time, in seconds.
+	 * @param OutEntries The expired entries.
+	 */
+	void PopExpired(const double Now, TArray<FEntry>& OutEntries);
+
+	// Returns the number of entries in the queue, including stale ones.
+	FORCEINLINE int32 Num() const { return Heap.Num(); }
+
+	// Returns the memory allocated by the queue.
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Heap.GetAllocatedSize(); }
+
+private:
+
+	struct FEntryPredicate
+	{
+		FORCEINLINE bool operator()(const FEntry& A, const FEntry& B) const { return A.Deadline < B.Deadline; }
+	};
+
+	// Entries sorted by deadline.
+	TArray<FEntry> Heap;
+
+	uint32 NextSerial;
+};
@@ -0,0 +1,97 @@
+/*
+
+MIT License
+
+Copyright (c) 2020 Younes AIT AMER MEZIANE
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Least recently used cache of released assets, bounded by their size in memory.
+ * Only does the bookkeeping: the subsystem keeps cached assets alive and unloads them once they're evicted.
+ * Entries are identified by the index of their asset record, and removed using the slot returned when they were added.
+ */
+class SIMPLEASSETSTREAMING_API FAssetWarmCache
+{
+public:
+
+	FAssetWarmCache()
+		: Entries()
+		, Newest(INDEX_NONE)
+		, Oldest(INDEX_NONE)
+		, TotalBytes(0)
+	{}
+
+	/**
+	 * Add an asset to the cache as the most recently used one.
+	 * @param RecordIndex The index of the released asset's record.
+	 * @param SizeBytes The size of the asset in memory.
+	 * @returns The slot of the asset in the cache, used to remove it.
+	 */
+	int32 Add(const int32 RecordIndex, const int64 SizeBytes);
+
+	/**
+	 * Remove an asset from the cache, i.e. when it is requested again.
+	 * @param Slot The slot returned when the asset was added.
+	 */
+	void Remove(const int32 Slot);
+
+	/**
+	 * Remove the least recently used asset from the cache.
+	 * @param OutRecordIndex The record index of the evicted asset.
+	 * @returns False if the cache is empty.
+	 */
+	bool EvictOldest(int32& OutRecordIndex);
+
+	// Returns the number of cached assets.
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+	// Returns the memory allocated by the cache.
+	FORCEINLINE SIZE_T GetAllocatedSize() const { return Entries.GetAllocatedSize(); }
+
+	// Returns the total size of the cached assets.
+	FORCEINLINE int64 GetTotalBytes() const { return TotalBytes; }
+
+private:
+
+	struct FEntry
+	{
+		int32 RecordIndex;
+		int64 SizeBytes;
+		int32 Newer;
+		int32 Older;
+	};
+
+	// Entries linked from the newest to the oldest.
+	TSparseArray<FEntry> Entries;
+
+	// The most recently released asset.
+	int32 Newest;
+
+	// The least recently released asset, evicted first.
+	int32 Oldest;
+
+	int64 TotalBytes;
+};
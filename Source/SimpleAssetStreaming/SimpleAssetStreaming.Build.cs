@@ -38,6 +38,8 @@ public class SimpleAssetStreaming : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"AssetRegistry",
+				"PakFile",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);